@@ -0,0 +1,71 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <optional>
+#include <vector>
+
+namespace sdl3
+{
+    /// @brief Skyline rectangle packer for building texture atlases.
+    class AtlasPacker
+    {
+        public:
+            /// @brief Default constructor.
+            AtlasPacker() = default;
+
+            /// @brief Constructs a packer for an area of the size passed.
+            /// @param width Width of the area to pack into.
+            /// @param height Height of the area to pack into.
+            /// @param padding Number of empty pixels to leave between packed rectangles.
+            AtlasPacker(int width, int height, int padding = 1);
+
+            /// @brief Attempts to find room for a rectangle of the size passed.
+            /// @param width Width of the rectangle.
+            /// @param height Height of the rectangle.
+            /// @return Rectangle that was reserved on success. std::nullopt if it won't fit.
+            std::optional<SDL_Rect> pack(int width, int height);
+
+            /// @brief Clears everything packed so far.
+            void reset();
+
+            /// @brief Returns the width of the packing area.
+            int get_width() const noexcept;
+
+            /// @brief Returns the height of the packing area.
+            int get_height() const noexcept;
+
+        private:
+            // clang-format off
+            /// @brief A single segment of the skyline.
+            struct SkylineNode
+            {
+                int x{};
+                int y{};
+                int width{};
+            };
+            // clang-format on
+
+            /// @brief Width of the area.
+            int m_width{};
+
+            /// @brief Height of the area.
+            int m_height{};
+
+            /// @brief Padding between rectangles.
+            int m_padding{};
+
+            /// @brief Segments making up the skyline from left to right.
+            std::vector<AtlasPacker::SkylineNode> m_skyline{};
+
+            /// @brief Returns the Y a rectangle would sit at if placed starting at the node passed.
+            /// @param index Index of the node to start at.
+            /// @param width Width of the rectangle.
+            /// @param height Height of the rectangle.
+            /// @return Y coordinate on success. std::nullopt if the rectangle doesn't fit there.
+            std::optional<int> fit_at(size_t index, int width, int height) const noexcept;
+
+            /// @brief Raises the skyline to account for a newly placed rectangle.
+            /// @param index Index of the node the rectangle was placed at.
+            /// @param rect Rectangle that was placed.
+            void raise_skyline(size_t index, const SDL_Rect &rect);
+    };
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace sdl3
+{
+    /// @brief Compact open addressing hash table mapping codepoints to 32 bit values.
+    class CodepointMap
+    {
+        public:
+            /// @brief Default constructor.
+            CodepointMap() = default;
+
+            /// @brief Searches for the codepoint passed.
+            /// @param codepoint Codepoint to search for.
+            /// @return Value mapped to the codepoint. std::nullopt if it isn't in the map.
+            std::optional<uint32_t> find(char32_t codepoint) const noexcept;
+
+            /// @brief Maps the value passed to the codepoint, replacing the old value if there is one.
+            /// @param codepoint Codepoint to map.
+            /// @param value Value to map to it.
+            void insert(char32_t codepoint, uint32_t value);
+
+            /// @brief Removes the codepoint passed from the map.
+            /// @param codepoint Codepoint to remove.
+            /// @return True if the codepoint was in the map. False if it wasn't.
+            bool erase(char32_t codepoint) noexcept;
+
+            /// @brief Calls the function passed with every codepoint and value in the map.
+            /// @param function Function taking a char32_t codepoint and uint32_t value.
+            template <typename Function>
+            void for_each(Function &&function) const
+            {
+                for (const CodepointMap::Slot &slot : m_slots)
+                {
+                    if (slot.codepoint != EMPTY_SLOT) { function(slot.codepoint, slot.value); }
+                }
+            }
+
+            /// @brief Returns the number of codepoints in the map.
+            size_t size() const noexcept;
+
+            /// @brief Removes everything from the map.
+            void clear();
+
+        private:
+            // clang-format off
+            /// @brief Single slot in the table.
+            struct Slot
+            {
+                char32_t codepoint{};
+                uint32_t value{};
+            };
+            // clang-format on
+
+            /// @brief Key used to mark slots as empty. This is outside of the unicode range.
+            static constexpr char32_t EMPTY_SLOT = 0xFFFFFFFF;
+
+            /// @brief Number of slots allocated the first time something is inserted.
+            static constexpr size_t INITIAL_CAPACITY = 64;
+
+            /// @brief Slots. The size of this is always a power of two.
+            std::vector<CodepointMap::Slot> m_slots{};
+
+            /// @brief Number of slots in use.
+            size_t m_count{};
+
+            /// @brief Returns the slot the codepoint passed would ideally occupy.
+            size_t home_slot(char32_t codepoint) const noexcept;
+
+            /// @brief Doubles the size of the table and reinserts everything.
+            void grow();
+    };
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include "Renderer.hpp"
+#include "Texture.hpp"
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace sdl3
+{
+    /// @brief List of draw commands that are radix sorted by a 64 bit key and then executed in ascending key order.
+    class DrawList
+    {
+        public:
+            /// @brief Makes stuff easier to type.
+            using Callback = std::function<void(sdl3::Renderer &)>;
+
+            // No copying or moving.
+            DrawList(const DrawList &)            = delete;
+            DrawList(DrawList &&)                 = delete;
+            DrawList &operator=(const DrawList &) = delete;
+            DrawList &operator=(DrawList &&)      = delete;
+
+            /// @brief Default constructor.
+            DrawList() = default;
+
+            /// @brief Packs the parts of a sort key together. Earlier parameters take priority when sorting.
+            /// @param layer Layer the command is drawn on.
+            /// @param depth Depth within the layer. Lower depths are drawn first.
+            /// @param textureId Texture id from Texture::get_id. Only the lower 24 bits are used.
+            /// @param blend Blend group. Only used for ordering.
+            /// @return Sort key.
+            static uint64_t make_key(uint8_t layer, uint16_t depth, uint32_t textureId, uint8_t blend) noexcept;
+
+            /// @brief Queues the whole texture to be rendered at the coordinates passed.
+            /// @param key Sort key.
+            /// @param texture Texture to render. This needs to stay alive until the list is executed.
+            /// @param x X coordinate.
+            /// @param y Y coordinate.
+            void add_texture(uint64_t key, sdl3::Texture &texture, int x, int y);
+
+            /// @brief Queues part of a texture to be rendered.
+            /// @param key Sort key.
+            /// @param texture Texture to render. This needs to stay alive until the list is executed.
+            /// @param sourceRect Part of the texture to render.
+            /// @param destRect Where to render it.
+            void add_texture_part(uint64_t key, sdl3::Texture &texture, const SDL_Rect &sourceRect, const SDL_Rect &destRect);
+
+            /// @brief Queues a filled rect. Rects next to each other in the sorted list are rendered together.
+            /// @param key Sort key.
+            /// @param rect Rect to fill.
+            /// @param color Color to fill it with.
+            void add_rect(uint64_t key, const SDL_FRect &rect, SDL_Color color);
+
+            /// @brief Queues a function to be called. The sprite batch is flushed before it's called.
+            /// @param key Sort key.
+            /// @param callback Function to call.
+            void add_callback(uint64_t key, DrawList::Callback callback);
+
+            /// @brief Sorts and renders everything queued. Textures sharing a key range are merged by the sprite batch.
+            /// @param renderer Renderer to render with.
+            /// @return True on success. False if anything failed to render.
+            bool execute(sdl3::Renderer &renderer);
+
+            /// @brief Removes every command. The memory is kept for the next frame.
+            void clear();
+
+            /// @brief Returns the number of commands queued.
+            size_t size() const noexcept;
+
+        private:
+            // clang-format off
+            /// @brief A single queued draw.
+            struct Command
+            {
+                enum class Type : uint8_t
+                {
+                    Texture,
+                    Rect,
+                    Callback
+                };
+
+                DrawList::Command::Type type{};
+                sdl3::Texture *texture{};
+                SDL_Rect sourceRect{};
+                SDL_Rect destRect{};
+                SDL_FRect rect{};
+                SDL_Color color{};
+                size_t callback{};
+            };
+
+            /// @brief Key and command index. This is what actually gets sorted.
+            struct SortEntry
+            {
+                uint64_t key{};
+                uint32_t command{};
+            };
+            // clang-format on
+
+            /// @brief Commands in submission order.
+            std::vector<DrawList::Command> m_commands{};
+
+            /// @brief Callbacks referenced by commands.
+            std::vector<DrawList::Callback> m_callbacks{};
+
+            /// @brief Sort entries.
+            std::vector<DrawList::SortEntry> m_entries{};
+
+            /// @brief Scratch buffer the radix sort ping pongs with.
+            std::vector<DrawList::SortEntry> m_sortBuffer{};
+
+            /// @brief Rects gathered during execution so runs of them go to the renderer in one call.
+            std::vector<SDL_FRect> m_rects{};
+
+            /// @brief Colors of the gathered rects.
+            std::vector<SDL_Color> m_rectColors{};
+
+            /// @brief Whether or not the entries are already sorted.
+            bool m_sorted = true;
+
+            /// @brief Queues a command.
+            /// @param key Sort key.
+            /// @param command Command to queue.
+            void push_command(uint64_t key, const DrawList::Command &command);
+
+            /// @brief Renders the gathered rects and clears them.
+            /// @param renderer Renderer to render with.
+            /// @return True on success. False on failure.
+            bool flush_rects(sdl3::Renderer &renderer);
+
+            /// @brief Stable LSD radix sort of the entries by key.
+            void sort();
+    };
+}
@@ -1,15 +1,24 @@
 #pragma once
 
+#include "AtlasPacker.hpp"
+#include "CodepointMap.hpp"
 #include "Freetype.hpp"
+#include "MappedFile.hpp"
 #include "OptionalReference.hpp"
 #include "Texture.hpp"
 
 #include <SDL3/SDL.h>
+#include <array>
 #include <ft2build.h>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
+#include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 #include FT_FREETYPE_H
 
 // The code here is based on the freetype tutorial.
@@ -32,10 +41,43 @@ namespace sdl3
                 int16_t advanceX{};
                 int16_t top{};
                 int16_t left{};
-                sdl3::SharedTexture texture{};
+                uint16_t page{};
+                SDL_Rect source{};
+            };
+
+            /// @brief Single line produced by the line breaker.
+            struct LineRecord
+            {
+                size_t begin{};
+                size_t end{};
+                int width{};
+                int baseline{};
+            };
+
+            /// @brief Extents of a block of text.
+            struct TextMetrics
+            {
+                int width{};
+                int height{};
+                size_t lineCount{};
+            };
+
+            /// @brief Layout cache statistics for sizing the cache.
+            struct LayoutCacheStats
+            {
+                uint64_t hits{};
+                uint64_t misses{};
+                size_t size{};
+                size_t capacity{};
             };
             // clang-format on
 
+            // No copying or moving. Fonts sharing a memory budget keep track of each other by address.
+            Font(const Font &)            = delete;
+            Font(Font &&)                 = delete;
+            Font &operator=(const Font &) = delete;
+            Font &operator=(Font &&)      = delete;
+
             /// @brief Default constructor.
             Font() = default;
 
@@ -45,10 +87,16 @@ namespace sdl3
             /// @param pixelSize Size of the font in pixels.
             Font(std::string_view fontPath, int pixelSize);
 
-            /// @brief Frees the Freetype face.
+            /// @brief Frees the glyph pages and the Freetype faces.
             ~Font();
 
-            /// @brief Renders text to the target using the font.
+            /// @brief Adds a font to search for codepoints the font and the fallbacks added before it don't have.
+            /// @param fontPath Path of the font to fall back to.
+            /// @return True on success. False on failure.
+            /// @note Glyphs already cached are thrown out so they're resolved against the new chain.
+            bool add_fallback_font(std::string_view fontPath);
+
+            /// @brief Renders UTF-8 text to the target using the font.
             /// @param target Target to render to.
             /// @param x X coordinate to render to.
             /// @param y Y coordinate to render to.
@@ -56,7 +104,7 @@ namespace sdl3
             /// @param text Text to render.
             void render_text(int x, int y, SDL_Color renderColor, std::string_view text);
 
-            /// @brief Renders the text wrapped to the target using the arguments passed.
+            /// @brief Renders the UTF-8 text wrapped to the target using the arguments passed.
             /// @param target Target to render text to.
             /// @param x X coordinate to render text to.
             /// @param y Y coordinate to render text to.
@@ -65,38 +113,418 @@ namespace sdl3
             /// @param text Text to render.
             void render_text_wrapped(int x, int y, int maxWidth, SDL_Color renderColor, std::string_view text);
 
-            /// @brief Returns the width of the string in pixels.
+            /// @brief Blends UTF-8 text straight into a surface on the CPU. This doesn't need a renderer.
+            /// @param surface Surface to render to. This has to be a 32 bit format.
+            /// @param x X coordinate to render to.
+            /// @param y Y coordinate to render to.
+            /// @param renderColor Color to render the text with.
+            /// @param text Text to render.
+            /// @return True on success. False on failure.
+            bool render_text_to_surface(sdl3::Surface &surface, int x, int y, SDL_Color renderColor, std::string_view text);
+
+            /// @brief Returns the width of the UTF-8 string in pixels.
             /// @param text Text to get the width of.
             /// @return Width of the text in pixels.
             size_t get_text_width(std::string_view text);
 
+            /// @brief Measures the UTF-8 text as if it were rendered with render_text without rendering it.
+            /// @param text Text to measure.
+            /// @return Width and height of the block of text and the number of lines it spans.
+            Font::TextMetrics measure_text(std::string_view text);
+
+            /// @brief Measures the UTF-8 text as if it were rendered with render_text_wrapped without rendering it.
+            /// @param text Text to measure.
+            /// @param maxWidth Maximum width of a line before a new one is started.
+            /// @return Width and height of the block of text and the number of lines it spans.
+            Font::TextMetrics measure_text_wrapped(std::string_view text, int maxWidth);
+
+            /// @brief Returns the lines the UTF-8 text is broken into when wrapped at the width passed.
+            /// @param text Text to break.
+            /// @param maxWidth Maximum width of a line before a new one is started.
+            /// @return Span of line records. Byte ranges index into text. This is only valid until the next string is laid
+            /// out.
+            std::span<const Font::LineRecord> get_text_lines(std::string_view text, int maxWidth);
+
+            /// @brief Starts rasterizing the glyphs for every codepoint in the UTF-8 charset passed on worker threads.
+            /// @param charset Characters to preload.
+            void preload(std::string_view charset);
+
+            /// @brief Uploads glyphs finished by the workers to the atlas. This should be called once a frame on the render
+            /// thread while warming up.
+            /// @param budgetMs Maximum number of milliseconds to spend uploading.
+            /// @return True once every preloaded glyph has been uploaded.
+            bool upload_preloaded(uint64_t budgetMs);
+
+            /// @brief Returns whether or not every glyph requested through preload has been rasterized and uploaded.
+            bool preload_complete() const;
+
+            /// @brief Sets the maximum number of laid out strings the font keeps around. 0 disables the cache.
+            /// @param capacity Maximum number of layouts to cache.
+            void set_layout_cache_capacity(size_t capacity);
+
+            /// @brief Throws away every cached layout.
+            void clear_layout_cache();
+
+            /// @brief Returns the hit and miss counts for the layout cache.
+            Font::LayoutCacheStats get_layout_cache_stats() const noexcept;
+
+            /// @brief Resets the layout cache hit and miss counters.
+            void reset_layout_cache_stats() noexcept;
+
+            /// @brief Writes every cached glyph and the atlas pages they're on to a cache file. The file is keyed to the font
+            /// files and pixel size and is meant for the machine that wrote it.
+            /// @param cachePath Path of the file to write.
+            /// @return True on success. False on failure.
+            bool save_cache(std::string_view cachePath) const;
+
+            /// @brief Loads glyphs from a file written by save_cache and uploads their pages directly. Glyphs already cached
+            /// are skipped and anything not in the file is still loaded with Freetype when it's needed.
+            /// @param cachePath Path of the file to load.
+            /// @return True on success. False if the file is missing, corrupt or was written for different font files or
+            /// a different size.
+            bool load_cache(std::string_view cachePath);
+
+            /// @brief Sets the most memory the font's glyph pages can use. The least recently used pages are evicted past it.
+            /// @param budgetBytes Budget in bytes. 0 means unlimited.
+            void set_glyph_memory_budget(size_t budgetBytes);
+
+            /// @brief Returns the number of bytes the font's glyph pages are using. That's their textures plus the CPU side
+            ///        copy of their coverage.
+            size_t get_glyph_memory_usage() const noexcept;
+
+            /// @brief Sets the most memory the glyph pages of every font combined can use.
+            /// @param budgetBytes Budget in bytes. 0 means unlimited.
+            static void set_shared_glyph_memory_budget(size_t budgetBytes);
+
+            /// @brief Returns the number of bytes the glyph pages of every font combined are using.
+            static size_t get_shared_glyph_memory_usage() noexcept;
+
         private:
+            // clang-format off
+            /// @brief Atlas page glyphs are packed into.
+            struct AtlasPage
+            {
+                sdl3::SharedTexture texture{};
+                sdl3::AtlasPacker packer{};
+                bool alphaOnly{};
+                size_t memorySize{};
+                uint64_t lastUse{};
+                std::vector<char32_t> codepoints{};
+                std::vector<uint8_t> coverage{};
+            };
+
+            /// @brief View of an 8 bit coverage bitmap.
+            struct GlyphBitmap
+            {
+                const uint8_t *buffer{};
+                int width{};
+                int height{};
+                int pitch{};
+            };
+
+            /// @brief Font file and the face created from it at the font's size.
+            struct FontFace
+            {
+                sdl3::SharedMappedFile file{};
+                FT_Face face{};
+            };
+
+            /// @brief Codepoint a preload worker should rasterize and which face to use.
+            struct GlyphRequest
+            {
+                char32_t codepoint{};
+                uint32_t face{};
+            };
+
+            /// @brief Glyph rasterized by a preload worker waiting to be uploaded.
+            struct RasterGlyph
+            {
+                char32_t codepoint{};
+                Font::GlyphData glyphData{};
+                int width{};
+                int height{};
+                std::vector<uint8_t> coverage{};
+            };
+
+            /// @brief State shared between the font and its preload workers.
+            struct PreloadState
+            {
+                std::mutex mutex{};
+                std::vector<Font::RasterGlyph> ready{};
+                size_t pendingJobs{};
+            };
+
+            /// @brief Glyph placed relative to the top left of a layout.
+            struct PositionedGlyph
+            {
+                int16_t x{};
+                int16_t y{};
+                uint16_t page{};
+                SDL_Rect source{};
+            };
+
+            /// @brief Positioned glyph run for a string, the lines it was broken into and its extents.
+            struct TextLayout
+            {
+                std::vector<Font::PositionedGlyph> glyphs{};
+                std::vector<Font::LineRecord> lines{};
+                int width{};
+                int height{};
+            };
+
+            /// @brief Cached layout and the key it was laid out with.
+            struct LayoutEntry
+            {
+                std::string text{};
+                int wrapWidth{};
+                uint64_t generation{};
+                Font::TextLayout layout{};
+            };
+
+            /// @brief Key for looking layouts up. The text views the string owned by the entry.
+            struct LayoutKey
+            {
+                std::string_view text{};
+                int wrapWidth{};
+
+                bool operator==(const LayoutKey &) const = default;
+            };
+
+            /// @brief Hashing for the layout key.
+            struct LayoutKeyHash
+            {
+                size_t operator()(const LayoutKey &key) const noexcept
+                {
+                    const size_t wrapHash = static_cast<size_t>(key.wrapWidth) * 0x9E3779B97F4A7C15ull;
+                    return std::hash<std::string_view>{}(key.text) ^ wrapHash;
+                }
+            };
+            // clang-format on
+
+            /// @brief Makes the layout list easier to type.
+            using LayoutList = std::list<Font::LayoutEntry>;
+
+            /// @brief Face index recorded for codepoints that can't be loaded so they aren't retried.
+            static constexpr uint32_t MISSING_GLYPH = 0xFFFFFFFF;
+
+            /// @brief Wrap width used for text that isn't wrapped.
+            static constexpr int NO_WRAP = -1;
+
+            /// @brief Default number of layouts cached.
+            static constexpr size_t DEFAULT_LAYOUT_CAPACITY = 256;
+
+            /// @brief Minimum number of codepoints handed to a single preload worker.
+            static constexpr size_t PRELOAD_CHUNK_SIZE = 32;
+
+            /// @brief Width and height of atlas pages.
+            static constexpr int ATLAS_PAGE_SIZE = 512;
+
+            /// @brief Number of codepoints looked up directly instead of hashed. This covers ASCII and Latin-1.
+            static constexpr size_t FLAT_GLYPH_COUNT = 256;
+
             /// @brief Stores whether or not loading the font was successful.
             bool m_isValid{};
 
             /// @brief Size of the glyphs in pixels.
             int m_pixelSize{};
 
-            /// @brief Font face used.
-            FT_Face m_fontFace{};
+            /// @brief Faces searched for glyphs in order. The first is the font itself and the rest are fallbacks. The mapped
+            /// files are shared with every other font loaded from the same file.
+            std::vector<Font::FontFace> m_faces{};
+
+            /// @brief Index of the face each codepoint seen so far resolved to. MISSING_GLYPH for glyphs that failed to load.
+            sdl3::CodepointMap m_faceMap{};
+
+            /// @brief Every glyph loaded by the font.
+            std::vector<Font::GlyphData> m_glyphs{};
+
+            /// @brief Indices into m_glyphs plus one for codepoints below FLAT_GLYPH_COUNT. Zero means not loaded yet.
+            std::array<uint32_t, FLAT_GLYPH_COUNT> m_flatGlyphs{};
+
+            /// @brief Indices into m_glyphs for every other codepoint.
+            sdl3::CodepointMap m_glyphMap{};
+
+            /// @brief Atlas pages the glyphs are packed into. Evicted pages have no texture and are reused by the next page.
+            std::vector<Font::AtlasPage> m_pages{};
+
+            /// @brief Vertices queued for each atlas page waiting to be submitted.
+            std::vector<std::vector<SDL_Vertex>> m_pageVertices{};
+
+            /// @brief Cached layouts, most recently used first.
+            Font::LayoutList m_layoutList{};
+
+            /// @brief Layouts mapped to their key for quick searching.
+            std::unordered_map<Font::LayoutKey, Font::LayoutList::iterator, Font::LayoutKeyHash> m_layoutMap{};
+
+            /// @brief Maximum number of layouts cached.
+            size_t m_layoutCapacity = DEFAULT_LAYOUT_CAPACITY;
+
+            /// @brief Number of layout cache hits.
+            uint64_t m_layoutHits{};
+
+            /// @brief Number of layout cache misses.
+            uint64_t m_layoutMisses{};
+
+            /// @brief Layout used when the cache is disabled.
+            Font::TextLayout m_scratchLayout{};
+
+            /// @brief Shared quad index buffer. Every quad uses the same pattern so this only ever grows.
+            std::vector<int> m_quadIndices{};
 
-            /// @brief Buffer for storing the font in RAM. This makes accessing it faster.
-            std::unique_ptr<char[]> m_fontBuffer{};
+            /// @brief Page glyphs are currently being packed into.
+            size_t m_currentPage{};
 
-            /// @brief Glyphs mapped to their char for quick searching and retrieval.
-            std::unordered_map<char, Font::GlyphData> m_cacheMap{};
+            /// @brief Slots in m_glyphs freed by evicted glyphs.
+            std::vector<uint32_t> m_freeGlyphSlots{};
+
+            /// @brief Memory budget for this font's pages. 0 is unlimited.
+            size_t m_glyphMemoryBudget{};
+
+            /// @brief Memory used by this font's pages.
+            size_t m_glyphMemoryUsage{};
+
+            /// @brief Incremented every time a page is evicted. Layouts built before that are stale.
+            uint64_t m_evictionGeneration{};
+
+            /// @brief Memory budget for every font's pages combined. 0 is unlimited.
+            static inline size_t sm_sharedGlyphBudget{};
+
+            /// @brief Memory used by every font's pages combined.
+            static inline size_t sm_sharedGlyphUsage{};
+
+            /// @brief Ticks every time a layout is built. Pages are stamped with this when used.
+            static inline uint64_t sm_useClock{};
+
+            /// @brief Every font loaded. The shared budget evicts from whichever has the coldest page.
+            static inline std::vector<sdl3::Font *> sm_fonts{};
+
+            /// @brief Scratch buffer coverage is expanded into for pages that aren't alpha only.
+            std::vector<uint32_t> m_expandBuffer{};
+
+            /// @brief Preload state shared with the workers.
+            std::shared_ptr<Font::PreloadState> m_preload = std::make_shared<Font::PreloadState>();
+
+            /// @brief Glyphs taken from the workers that haven't been uploaded yet.
+            std::vector<Font::RasterGlyph> m_uploadQueue{};
+
+            /// @brief Index of the next glyph in the upload queue.
+            size_t m_uploadIndex{};
 
             /// @brief All font instances share this instance of freetype.
             static inline sdl3::Freetype sm_freetype{};
 
-            /// @brief Attempts to find the glyph for the character passed. If that fails, it's loaded using freetype.
-            /// @param charCode Character to search for or load.
-            /// @return Pointer to cached glyph data on success. nullptr on failure.
-            sdl3::OptionalReference<Font::GlyphData> find_load_glyph(char charCode);
+            /// @brief Attempts to find the glyph for the codepoint passed. If that fails, it's loaded using freetype.
+            /// @param codepoint Codepoint to search for or load.
+            /// @return Reference to cached glyph data on success. std::nullopt on failure. This is only valid until the next
+            /// glyph is loaded.
+            sdl3::OptionalReference<Font::GlyphData> find_load_glyph(char32_t codepoint);
+
+            /// @brief Returns a hash of every font file in the face chain, in order. Cache files are keyed to this. Each file's
+            ///        hash is worked out once and shared by every font using it.
+            uint64_t get_cache_key() const;
+
+            /// @brief Returns the index of the first face that has the codepoint passed. This is memoized.
+            /// @param codepoint Codepoint to resolve.
+            /// @return Index into m_faces. Codepoints no face has resolve to the font itself so its missing glyph box is
+            /// rendered. MISSING_GLYPH if the codepoint failed to load before.
+            uint32_t resolve_face(char32_t codepoint);
+
+            /// @brief Opens a face for the file passed and sets it to the size passed.
+            /// @param library Freetype library to open the face with.
+            /// @param fontFile Font file to open.
+            /// @param pixelSize Size of the glyphs in pixels.
+            /// @return Face on success. nullptr on failure.
+            static FT_Face open_face(FT_Library library, const sdl3::MappedFile &fontFile, int pixelSize);
+
+            /// @brief Searches the cache for the codepoint passed.
+            /// @param codepoint Codepoint to search for.
+            /// @return Index of the glyph in m_glyphs. std::nullopt if it isn't cached.
+            std::optional<uint32_t> find_glyph_index(char32_t codepoint) const noexcept;
+
+            /// @brief Packs the bitmap passed into the atlas and adds the glyph to the cache.
+            /// @param codepoint Codepoint the glyph belongs to.
+            /// @param glyphData Metrics of the glyph.
+            /// @param glyphBitmap Coverage bitmap of the glyph.
+            /// @return Reference to the cached glyph on success. std::nullopt on failure.
+            sdl3::OptionalReference<Font::GlyphData> insert_glyph(char32_t codepoint,
+                                                                  Font::GlyphData glyphData,
+                                                                  const Font::GlyphBitmap &glyphBitmap);
+
+            /// @brief Records a glyph that's already been packed in the cache.
+            /// @param codepoint Codepoint of the glyph.
+            /// @param glyphData Metrics of the glyph and where it was packed.
+            /// @return Reference to the cached glyph. This is only valid until the next glyph is loaded.
+            Font::GlyphData &store_glyph(char32_t codepoint, const Font::GlyphData &glyphData);
+
+            /// @brief Rasterizes the codepoints passed using a library and faces of its own. This runs on the workers.
+            /// @param state Preload state to hand the glyphs to.
+            /// @param fontFiles Mapped font files in face order. Holding these keeps the mappings alive until the job is done.
+            /// @param pixelSize Size of the glyphs in pixels.
+            /// @param requests Codepoints to rasterize and the faces to use for them.
+            static void rasterize_glyphs(std::shared_ptr<Font::PreloadState> state,
+                                         std::vector<sdl3::SharedMappedFile> fontFiles,
+                                         int pixelSize,
+                                         std::vector<Font::GlyphRequest> requests);
+
+            /// @brief Returns the layout for the text passed, laying it out if it isn't cached.
+            /// @param text Text to get the layout of.
+            /// @param wrapWidth Width to wrap the text at. NO_WRAP to not wrap it.
+            /// @return Reference to the layout. This is only valid until the next layout is requested.
+            const Font::TextLayout &get_layout(std::string_view text, int wrapWidth);
+
+            /// @brief Breaks the text passed into lines and positions every glyph in a single pass.
+            /// @param text Text to lay out.
+            /// @param wrapWidth Width to wrap the text at. NO_WRAP to not wrap it.
+            /// @param layout Layout to write to.
+            void build_layout(std::string_view text, int wrapWidth, Font::TextLayout &layout);
+
+            /// @brief Queues and renders every glyph in the layout passed.
+            /// @param x X coordinate to render to.
+            /// @param y Y coordinate to render to.
+            /// @param renderColor Color to render the text with.
+            /// @param layout Layout to render.
+            void render_layout(int x, int y, SDL_Color renderColor, const Font::TextLayout &layout);
+
+            /// @brief Finds room for the bitmap passed in the atlas and uploads it.
+            /// @param glyphBitmap Bitmap to pack.
+            /// @param glyphData Glyph data to write the page and source rect to.
+            /// @return True on success. False on failure.
+            bool pack_glyph_bitmap(const Font::GlyphBitmap &glyphBitmap, Font::GlyphData &glyphData);
+
+            /// @brief Evicts the least recently used pages until the bytes passed fit in both budgets. Pages used by the layout
+            /// being built are never evicted, so the budget can be exceeded until they aren't in use anymore.
+            /// @param incomingBytes Number of bytes about to be allocated.
+            void make_room(size_t incomingBytes);
+
+            /// @brief Frees the page passed and forgets every glyph on it.
+            /// @param pageIndex Index of the page to evict.
+            void evict_page(size_t pageIndex);
+
+            /// @brief Uploads coverage to the part of the page passed, expanding it first if the page isn't alpha only. Pages
+            /// created without a renderer only live on the CPU side and skip this.
+            /// @param page Page to upload to.
+            /// @param rect Part of the page to update.
+            /// @param coverage Coverage to upload.
+            /// @param pitch Number of bytes per row in coverage.
+            /// @return True on success. False on failure.
+            bool upload_coverage(Font::AtlasPage &page, const SDL_Rect &rect, const uint8_t *coverage, int pitch);
+
+            /// @brief Creates a new, empty atlas page.
+            /// @param pageWidth Width of the page.
+            /// @param pageHeight Height of the page.
+            /// @note Pages store coverage as 8 bit palette indices when the renderer supports it. Otherwise they are 32 bit.
+            /// @return Index of the new page.
+            size_t create_atlas_page(int pageWidth, int pageHeight);
+
+            /// @brief Queues a quad for the glyph passed at the coordinates passed.
+            /// @param x X coordinate of the glyph.
+            /// @param y Y coordinate of the glyph.
+            /// @param page Atlas page the glyph is on.
+            /// @param source Where the glyph is on the page.
+            /// @param color Color to render the glyph with.
+            void queue_glyph(int x, int y, uint16_t page, const SDL_Rect &source, SDL_FColor color);
 
-            /// @brief Takes the bitmap passed, blits it to a surface, and then returns it as an SDL texture.
-            /// @param glyphBitmap Bitmap to convert.
-            /// @return Shared texture containing the glyph, nullptr on failure.
-            sdl3::SharedTexture convert_glyph_to_texture(char charCode, const FT_Bitmap glyphBitmap);
+            /// @brief Submits every queued glyph quad, one call per atlas page.
+            void flush_glyphs();
     };
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+
+namespace sdl3
+{
+    /// @brief Forward declaration for the renderer.
+    class Renderer;
+
+    /// @brief Paces frames to a target rate and runs updates on a fixed timestep. Frames are paced with vsync if the
+    /// renderer supports it. Otherwise the pacer sleeps until the next frame is due and spins for the last bit.
+    class FramePacer
+    {
+        public:
+            /// @brief Creates a pacer.
+            /// @param frameRate Frames per second to pace to when vsync isn't available. 0 doesn't limit the rate.
+            /// @param updateRate Fixed updates per second.
+            FramePacer(double frameRate = 60.0, double updateRate = 60.0) noexcept;
+
+            /// @brief Turns vsync on for the renderer passed. Frames aren't slept for while it's on.
+            /// @param renderer Renderer to enable vsync on.
+            /// @return True if vsync is on. False if the renderer doesn't support it.
+            bool enable_vsync(sdl3::Renderer &renderer);
+
+            /// @brief Sets the rate frames are paced to when vsync isn't on.
+            /// @param frameRate Frames per second. 0 doesn't limit the rate.
+            void set_frame_rate(double frameRate) noexcept;
+
+            /// @brief Sets the rate of fixed updates.
+            /// @param updateRate Updates per second.
+            void set_update_rate(double updateRate) noexcept;
+
+            /// @brief Starts a frame. The time since the last frame is added to the update accumulator.
+            void begin_frame() noexcept;
+
+            /// @brief Takes a fixed update's worth of time out of the accumulator. Call this in a loop.
+            /// @return True if an update should run. False once the accumulator doesn't hold a full update.
+            bool step() noexcept;
+
+            /// @brief Ends the frame, sleeping until the next one is due if vsync isn't on.
+            void end_frame() noexcept;
+
+            /// @brief Returns the length of a fixed update in seconds.
+            double get_update_delta() const noexcept;
+
+            /// @brief Returns how far between the last update and the next one the frame is, from 0 to 1. Rendering can
+            ///        use this to interpolate between the previous and current state.
+            double get_alpha() const noexcept;
+
+            /// @brief Returns the time the last frame took in seconds.
+            double get_frame_delta() const noexcept;
+
+            /// @brief Returns whether or not vsync is pacing frames.
+            bool is_vsync() const noexcept;
+
+        private:
+            /// @brief Longest frame the accumulator takes in. Anything longer is dropped so updates can catch up.
+            static constexpr double MAX_FRAME_DELTA = 0.25;
+
+            /// @brief Time before the deadline where sleeping stops and spinning starts. OS sleeps tend to overshoot.
+            static constexpr uint64_t SPIN_NS = 2000000;
+
+            /// @brief Performance counter ticks per second.
+            uint64_t m_frequency{};
+
+            /// @brief Performance counter ticks per frame. 0 means frames aren't limited.
+            uint64_t m_frameTicks{};
+
+            /// @brief Performance counter value the next frame is due at.
+            uint64_t m_nextFrame{};
+
+            /// @brief Performance counter value at the start of the last frame.
+            uint64_t m_lastFrame{};
+
+            /// @brief Length of a fixed update in seconds.
+            double m_updateDelta{};
+
+            /// @brief Time that hasn't been consumed by updates yet in seconds.
+            double m_accumulator{};
+
+            /// @brief Time the last frame took in seconds.
+            double m_frameDelta{};
+
+            /// @brief Whether or not vsync is on.
+            bool m_vsync{};
+    };
+}
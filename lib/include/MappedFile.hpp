@@ -0,0 +1,71 @@
+#pragma once
+#include "CoreComponent.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+
+namespace sdl3
+{
+    /// @brief Forward declaration for the following.
+    class MappedFile;
+
+    /// @brief Makes stuff easier to type.
+    using SharedMappedFile = std::shared_ptr<sdl3::MappedFile>;
+
+    /// @brief Read only view of an entire file. The file is memory mapped where possible and read into RAM otherwise.
+    class MappedFile : public sdl3::CoreComponent
+    {
+        public:
+            // No copying or moving.
+            MappedFile(const MappedFile &)            = delete;
+            MappedFile(MappedFile &&)                 = delete;
+            MappedFile &operator=(const MappedFile &) = delete;
+            MappedFile &operator=(MappedFile &&)      = delete;
+
+            /// @brief Maps the file at the path passed.
+            /// @param filePath Path of the file to map.
+            MappedFile(std::string_view filePath);
+
+            /// @brief Unmaps or frees the file.
+            ~MappedFile();
+
+            /// @brief Returns the contents of the file.
+            std::span<const uint8_t> get_data() const noexcept;
+
+            /// @brief Returns a 64 bit FNV-1a hash of the entire file. It's worked out on the first call and remembered, so
+            ///        everything sharing the file through MappedFileManager only pays for it once.
+            uint64_t get_hash() const;
+
+        private:
+            /// @brief Pointer to the start of the file.
+            const uint8_t *m_data{};
+
+            /// @brief Size of the file in bytes.
+            size_t m_size{};
+
+            /// @brief Whether or not m_data points to a mapping that needs to be unmapped.
+            bool m_isMapped{};
+
+            /// @brief Buffer the file is read to when mapping isn't available.
+            std::unique_ptr<uint8_t[]> m_buffer{};
+
+            /// @brief Hash of the file. Only valid once m_hashOnce has run.
+            mutable uint64_t m_hash{};
+
+            /// @brief Makes sure the hash is only worked out once, even if several threads ask at the same time.
+            mutable std::once_flag m_hashOnce{};
+
+            /// @brief Attempts to memory map the file.
+            /// @param filePath Path of the file.
+            /// @return True on success. False on failure.
+            bool map_file(std::string_view filePath);
+
+            /// @brief Reads the entire file to m_buffer.
+            /// @param filePath Path of the file.
+            /// @return True on success. False on failure.
+            bool read_file(std::string_view filePath);
+    };
+}
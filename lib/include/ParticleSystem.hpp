@@ -0,0 +1,140 @@
+#pragma once
+#include "Texture.hpp"
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <vector>
+
+namespace sdl3
+{
+    // clang-format off
+    /// @brief Starting state of a particle.
+    struct ParticleSpawn
+    {
+        /// @brief Position of the particle's center.
+        float x{};
+        float y{};
+
+        /// @brief Velocity in pixels per second.
+        float velocityX{};
+        float velocityY{};
+
+        /// @brief Number of seconds the particle lives for.
+        float lifetime{1.0f};
+
+        /// @brief Width and height the particle is rendered at.
+        float size{8.0f};
+
+        /// @brief Starting color. This is multiplied with the texture.
+        SDL_FColor color{1.0f, 1.0f, 1.0f, 1.0f};
+
+        /// @brief Change in color per second. Channels are clamped between 0 and 1.
+        SDL_FColor fade{0.0f, 0.0f, 0.0f, -1.0f};
+    };
+    // clang-format on
+
+    /// @brief Fixed size pool of particles sharing a texture. Particles are stored as separate arrays per attribute so
+    ///        updating them can use SIMD. The whole pool renders with a single geometry call.
+    class ParticleSystem
+    {
+        public:
+            // No copying or moving.
+            ParticleSystem(const ParticleSystem &)            = delete;
+            ParticleSystem(ParticleSystem &&)                 = delete;
+            ParticleSystem &operator=(const ParticleSystem &) = delete;
+            ParticleSystem &operator=(ParticleSystem &&)      = delete;
+
+            /// @brief Creates the pool. Everything is allocated here, so spawning and updating never allocate.
+            /// @param capacity Maximum number of particles alive at once.
+            /// @param texture Texture every particle renders with.
+            ParticleSystem(size_t capacity, sdl3::SharedTexture texture = nullptr);
+
+            /// @brief Sets the texture every particle renders with.
+            /// @param texture Texture to use.
+            void set_texture(sdl3::SharedTexture texture) noexcept;
+
+            /// @brief Sets the acceleration applied to every particle.
+            /// @param x Horizontal acceleration in pixels per second squared.
+            /// @param y Vertical acceleration in pixels per second squared.
+            void set_gravity(float x, float y) noexcept;
+
+            /// @brief Spawns a particle.
+            /// @param spawn Starting state of the particle.
+            /// @return True on success. False if the pool is full.
+            bool spawn(const sdl3::ParticleSpawn &spawn) noexcept;
+
+            /// @brief Moves, ages and fades every particle. Particles whose lifetime runs out are removed.
+            /// @param deltaTime Number of seconds to advance by.
+            void update(float deltaTime) noexcept;
+
+            /// @brief Renders every particle. This goes through the sprite batch if it's active.
+            /// @return True on success. False on failure or if there's no texture.
+            bool render();
+
+            /// @brief Removes every particle.
+            void clear() noexcept;
+
+            /// @brief Returns the number of particles alive.
+            size_t size() const noexcept;
+
+            /// @brief Returns the maximum number of particles.
+            size_t get_capacity() const noexcept;
+
+        private:
+            /// @brief Attributes stored per particle. Each gets its own array.
+            enum class Stream
+            {
+                X,
+                Y,
+                VelocityX,
+                VelocityY,
+                Life,
+                Size,
+                Red,
+                Green,
+                Blue,
+                Alpha,
+                FadeRed,
+                FadeGreen,
+                FadeBlue,
+                FadeAlpha,
+                Count
+            };
+
+            /// @brief Number of attribute arrays.
+            static constexpr size_t STREAM_COUNT = static_cast<size_t>(Stream::Count);
+
+            /// @brief Number of color channels.
+            static constexpr size_t CHANNEL_COUNT = 4;
+
+            /// @brief Maximum number of particles.
+            size_t m_capacity{};
+
+            /// @brief Number of particles alive. These are always the first m_count entries of every stream.
+            size_t m_count{};
+
+            /// @brief Every attribute array back to back. Each one is m_capacity long.
+            std::vector<float> m_streams{};
+
+            /// @brief Texture particles render with.
+            sdl3::SharedTexture m_texture{};
+
+            /// @brief Acceleration applied to every particle.
+            float m_gravityX{};
+
+            /// @brief Acceleration applied to every particle.
+            float m_gravityY{};
+
+            /// @brief Vertices built each render. Four per particle.
+            std::vector<SDL_Vertex> m_vertices{};
+
+            /// @brief Indices for every particle's quad. These never change, so they're built once.
+            std::vector<int> m_indices{};
+
+            /// @brief Returns the start of the attribute array passed.
+            float *get_stream(ParticleSystem::Stream stream) noexcept;
+
+            /// @brief Swap removes every particle whose lifetime has run out.
+            void remove_dead() noexcept;
+    };
+}
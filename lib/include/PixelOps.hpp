@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+
+namespace sdl3::pixel_ops
+{
+    // clang-format off
+    /// @brief Bit positions of the channels in a 32 bit pixel. Every channel has to be 8 bits.
+    struct PixelLayout
+    {
+        int redShift{};
+        int greenShift{};
+        int blueShift{};
+        int alphaShift{};
+    };
+    // clang-format on
+
+    /// @brief Expands 8 bit coverage into 32 bit pixels. SSE2 or NEON are used when available.
+    /// @param source Coverage to expand.
+    /// @param sourcePitch Number of bytes per row in source.
+    /// @param dest Pixels to write to.
+    /// @param destPitch Number of pixels per row in dest.
+    /// @param width Width of the area in pixels.
+    /// @param height Height of the area in pixels.
+    /// @param baseColor Color every pixel starts as. This should have the alpha bits cleared.
+    /// @param alphaShift Number of bits to shift coverage left by to land in the alpha channel.
+    void expand_coverage(const uint8_t *source,
+                         int sourcePitch,
+                         uint32_t *dest,
+                         int destPitch,
+                         int width,
+                         int height,
+                         uint32_t baseColor,
+                         int alphaShift) noexcept;
+
+    /// @brief Blends a color into 32 bit pixels using 8 bit coverage as the weight. SSE2 or NEON are used when available.
+    /// @param source Coverage to blend with.
+    /// @param sourcePitch Number of bytes per row in source.
+    /// @param dest Pixels to blend into. Every channel is blended the same way, so any 8888 format works.
+    /// @param destPitch Number of pixels per row in dest.
+    /// @param width Width of the area in pixels.
+    /// @param height Height of the area in pixels.
+    /// @param color Color to blend in. This should be in the format of dest with its alpha channel fully opaque.
+    /// @param alpha Alpha the coverage is scaled by.
+    void blend_coverage(const uint8_t *source,
+                        int sourcePitch,
+                        uint32_t *dest,
+                        int destPitch,
+                        int width,
+                        int height,
+                        uint32_t color,
+                        uint8_t alpha) noexcept;
+
+    /// @brief Converts 32 bit pixels from one channel layout to another. SSE2 or NEON are used when available.
+    /// @param source Pixels to convert.
+    /// @param sourcePitch Number of pixels per row in source.
+    /// @param dest Pixels to write to. This can't overlap source.
+    /// @param destPitch Number of pixels per row in dest.
+    /// @param width Width of the area in pixels.
+    /// @param height Height of the area in pixels.
+    /// @param sourceLayout Layout of the source pixels.
+    /// @param destLayout Layout to convert to.
+    /// @param premultiply Whether or not to multiply the color channels by alpha.
+    void convert_pixels(const uint32_t *source,
+                        int sourcePitch,
+                        uint32_t *dest,
+                        int destPitch,
+                        int width,
+                        int height,
+                        const sdl3::pixel_ops::PixelLayout &sourceLayout,
+                        const sdl3::pixel_ops::PixelLayout &destLayout,
+                        bool premultiply) noexcept;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <SDL3/SDL.h>
+
+namespace sdl3
+{
+    /// @brief Shadows the renderer's state so calls that wouldn't change anything never reach SDL.
+    class RenderState
+    {
+        public:
+            /// @brief Default constructor. Everything starts out unknown.
+            RenderState() = default;
+
+            /// @brief Sets the draw color.
+            /// @param renderer Renderer to set it on.
+            /// @param color Color to set.
+            /// @return True on success. False on failure.
+            bool set_draw_color(SDL_Renderer *renderer, SDL_Color color);
+
+            /// @brief Sets the blend mode used for primitives.
+            /// @param renderer Renderer to set it on.
+            /// @param blendMode Blend mode to set.
+            /// @return True on success. False on failure.
+            bool set_draw_blend_mode(SDL_Renderer *renderer, SDL_BlendMode blendMode);
+
+            /// @brief Sets the render target.
+            /// @param renderer Renderer to set it on.
+            /// @param target Target to set. nullptr is the framebuffer.
+            /// @return True on success. False on failure.
+            bool set_target(SDL_Renderer *renderer, SDL_Texture *target);
+
+            /// @brief Sets the clip rect.
+            /// @param renderer Renderer to set it on.
+            /// @param clip Clip rect to set. nullptr disables clipping.
+            /// @return True on success. False on failure.
+            bool set_clip(SDL_Renderer *renderer, const SDL_Rect *clip);
+
+            /// @brief Returns whether or not the target passed is already known to be set.
+            bool is_target(SDL_Texture *target) const noexcept;
+
+            /// @brief Returns whether or not the clip rect passed is already known to be set.
+            bool is_clip(const SDL_Rect *clip) const noexcept;
+
+            /// @brief Forgets everything. Needed after changing renderer state through SDL directly.
+            void invalidate() noexcept;
+
+        private:
+            /// @brief Current draw color.
+            SDL_Color m_drawColor{};
+
+            /// @brief Current primitive blend mode.
+            SDL_BlendMode m_drawBlendMode{};
+
+            /// @brief Current render target.
+            SDL_Texture *m_target{};
+
+            /// @brief Current clip rect.
+            SDL_Rect m_clip{};
+
+            /// @brief Whether or not clipping is enabled.
+            bool m_clipEnabled{};
+
+            /// @brief Whether or not m_drawColor matches SDL.
+            bool m_drawColorKnown{};
+
+            /// @brief Whether or not m_drawBlendMode matches SDL.
+            bool m_drawBlendModeKnown{};
+
+            /// @brief Whether or not m_target matches SDL.
+            bool m_targetKnown{};
+
+            /// @brief Whether or not the clip matches SDL.
+            bool m_clipKnown{};
+    };
+}
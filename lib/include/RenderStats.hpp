@@ -0,0 +1,110 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <array>
+#include <cstdint>
+#include <string>
+
+// These compile to nothing unless SDL3_RENDER_STATS is defined. CMake defines it with the SDL3_RENDER_STATS option.
+#ifdef SDL3_RENDER_STATS
+    #define RENDER_STATS_DRAW(texture, vertexCount) sdl3::RenderStats::record_draw(texture, vertexCount)
+    #define RENDER_STATS_ADD(counter)               ++sdl3::RenderStats::get_current_counters().counter
+    #define RENDER_STATS_FRAME_BEGIN()              sdl3::RenderStats::frame_begin()
+    #define RENDER_STATS_FRAME_END()                sdl3::RenderStats::frame_end()
+#else
+    #define RENDER_STATS_DRAW(texture, vertexCount)
+    #define RENDER_STATS_ADD(counter)
+    #define RENDER_STATS_FRAME_BEGIN()
+    #define RENDER_STATS_FRAME_END()
+#endif
+
+namespace sdl3
+{
+    // clang-format off
+    /// @brief Renderer counters collected over a frame.
+    struct RenderCounters
+    {
+        uint64_t drawCalls{};
+        uint64_t textureBinds{};
+        uint64_t modChanges{};
+        uint64_t targetSwitches{};
+        uint64_t vertices{};
+        uint64_t elidedCalls{};
+    };
+    // clang-format on
+
+    /// @brief Per frame renderer counters and a rolling histogram of frame times.
+    class RenderStats final
+    {
+        public:
+            // Everything here is static.
+            RenderStats() = delete;
+
+            /// @brief Starts timing a frame and resets the current counters. Renderer::frame_begin calls this.
+            static void frame_begin() noexcept;
+
+            /// @brief Stops timing the frame and records it. Renderer::frame_end calls this.
+            static void frame_end() noexcept;
+
+            /// @brief Records a draw call.
+            /// @param texture Texture the draw uses. A change from the last draw's texture counts as a bind.
+            /// @param vertexCount Number of vertices submitted.
+            static void record_draw(SDL_Texture *texture, size_t vertexCount) noexcept;
+
+            /// @brief Returns the counters for the frame in progress.
+            static sdl3::RenderCounters &get_current_counters() noexcept;
+
+            /// @brief Returns the counters for the last finished frame.
+            static const sdl3::RenderCounters &get_frame_counters() noexcept;
+
+            /// @brief Returns the CPU time of the last finished frame in milliseconds.
+            static double get_frame_time() noexcept;
+
+            /// @brief Returns the frame time at the percentile passed over the recent frames.
+            /// @param percentile Percentile from 0 to 100.
+            /// @return Frame time in milliseconds. This is the upper edge of the histogram bucket it lands in.
+            static double get_frame_time_percentile(double percentile) noexcept;
+
+            /// @brief Returns the last frame's counters and the frame time percentiles as a JSON object.
+            static std::string to_json();
+
+            /// @brief Clears the counters and the frame time history.
+            static void reset() noexcept;
+
+        private:
+            /// @brief Number of recent frames the histogram covers.
+            static constexpr size_t FRAME_WINDOW = 240;
+
+            /// @brief Width of a histogram bucket in milliseconds.
+            static constexpr double BUCKET_WIDTH = 0.25;
+
+            /// @brief Number of buckets. The last one catches everything past the others.
+            static constexpr size_t BUCKET_COUNT = 256;
+
+            /// @brief Counters for the frame in progress.
+            static inline sdl3::RenderCounters sm_current{};
+
+            /// @brief Counters for the last finished frame.
+            static inline sdl3::RenderCounters sm_lastFrame{};
+
+            /// @brief Texture used by the last draw.
+            static inline SDL_Texture *sm_lastTexture{};
+
+            /// @brief Performance counter at the start of the frame.
+            static inline uint64_t sm_frameStart{};
+
+            /// @brief Time of the last finished frame in milliseconds.
+            static inline double sm_frameTime{};
+
+            /// @brief Bucket every frame in the window landed in. This is a ring buffer.
+            static inline std::array<uint16_t, FRAME_WINDOW> sm_frameBuckets{};
+
+            /// @brief Next slot in sm_frameBuckets to write.
+            static inline size_t sm_frameIndex{};
+
+            /// @brief Number of frames recorded. Stops counting once the window is full.
+            static inline size_t sm_frameCount{};
+
+            /// @brief Number of frames in the window per bucket.
+            static inline std::array<uint32_t, BUCKET_COUNT> sm_histogram{};
+    };
+}
@@ -1,9 +1,14 @@
 #pragma once
 #include "CoreComponent.hpp"
+#include "RenderState.hpp"
+#include "SpriteBatch.hpp"
+#include "TargetPool.hpp"
 #include "Texture.hpp"
 #include "Window.hpp"
 
 #include <SDL3/SDL.h>
+#include <span>
+#include <vector>
 
 namespace sdl3
 {
@@ -24,6 +29,11 @@ namespace sdl3
             /// @param window Window to create the renderer with.
             Renderer(sdl3::Window &window);
 
+            /// @brief Creates a headless software renderer that draws into an offscreen surface.
+            /// @param width Width of the surface.
+            /// @param height Height of the surface.
+            Renderer(int width, int height);
+
             /// @brief Destroys the renderer.
             ~Renderer();
 
@@ -36,10 +46,18 @@ namespace sdl3
             /// @brief Sets the logical width and height of the renderer.
             bool set_logical_presentation(int width, int height);
 
+            /// @brief Sets the vsync interval of the renderer.
+            /// @param interval 1 syncs every refresh, 2 every other one and so on. 0 turns vsync off. -1 is adaptive.
+            /// @return True on success. False if the renderer doesn't support the interval.
+            bool set_vsync(int interval);
+
             /// @brief Sets the render target of the renderer.
             /// @param target Shared texture to target when rendering.
             bool set_render_target(sdl3::SharedTexture &target);
 
+            /// @brief Returns the current render target. This is Texture::NullTexture for the framebuffer.
+            sdl3::SharedTexture get_render_target() const noexcept;
+
             /// @brief Sets the renderer rendering clip region.
             /// @param x X coordinate.
             /// @param y Y coordinate.
@@ -47,13 +65,72 @@ namespace sdl3
             /// @param height Height of the area.
             bool set_render_clip(int x, int y, int width, int height);
 
+            /// @brief Sets the color used for clearing and primitives.
+            /// @param color Color to set.
+            bool set_draw_color(SDL_Color color);
+
+            /// @brief Sets the blend mode used for primitives.
+            /// @param blendMode Blend mode to set.
+            bool set_draw_blend_mode(SDL_BlendMode blendMode);
+
+            /// @brief Forgets the shadowed render state. Call this after changing renderer state through SDL directly.
+            void invalidate_state() noexcept;
+
+            /// @brief Clears the current render target to the color passed.
+            /// @param clear Color to clear to.
+            bool clear(SDL_Color clear);
+
+            /// @brief Fills rects in one geometry call. This goes through the sprite batch if it's active.
+            /// @param rects Rects to fill.
+            /// @param colors One color per rect, or a single color for all of them.
+            /// @note Primitives blend with the draw blend mode.
+            /// @return True on success. False on failure or if the number of colors doesn't match.
+            bool fill_rects(std::span<const SDL_FRect> rects, std::span<const SDL_Color> colors);
+
+            /// @brief Draws line segments one pixel wide in one geometry call. This goes through the sprite batch if it's
+            ///        active.
+            /// @param points Start and end points. Every two points form a segment.
+            /// @param colors One color per segment, or a single color for all of them.
+            /// @return True on success. False on failure or if the number of points or colors doesn't match.
+            bool draw_lines(std::span<const SDL_FPoint> points, std::span<const SDL_Color> colors);
+
+            /// @brief Draws points in one geometry call. This goes through the sprite batch if it's active.
+            /// @param points Points to draw.
+            /// @param colors One color per point, or a single color for all of them.
+            /// @return True on success. False on failure or if the number of colors doesn't match.
+            bool draw_points(std::span<const SDL_FPoint> points, std::span<const SDL_Color> colors);
+
             /// @brief Sets the target to the default framebuffer and clears it to the color passed.
             /// @param clear Color to clear the framebuffer to.
             bool frame_begin(SDL_Color clear);
 
-            /// @brief Ends the frame and presents it to screen.
+            /// @brief Ends the frame and presents it to screen. Flushes and ends the sprite batch if it's active.
             bool frame_end();
 
+            /// @brief Starts routing texture render calls into the sprite batch.
+            /// @param sortMode How the batch is ordered when it's flushed.
+            void begin_batch(sdl3::SpriteBatch::SortMode sortMode = sdl3::SpriteBatch::SortMode::Submission);
+
+            /// @brief Flushes the sprite batch and goes back to rendering immediately.
+            bool end_batch();
+
+            /// @brief Submits everything in the sprite batch without ending it.
+            bool flush_batch();
+
+            /// @brief Reads pixels back from the current render target. Anything batched is flushed first.
+            /// @param rect Area to read. nullptr reads the whole target.
+            /// @return Surface with the pixels. nullptr on failure.
+            sdl3::Surface read_pixels(const SDL_Rect *rect = nullptr);
+
+            /// @brief Returns whether or not the renderer draws into an offscreen surface instead of a window.
+            bool is_headless() const noexcept;
+
+            /// @brief Returns the sprite batch used by the renderer.
+            sdl3::SpriteBatch &get_sprite_batch() noexcept;
+
+            /// @brief Returns the pool of render targets owned by the renderer.
+            sdl3::TargetPool &get_target_pool() noexcept;
+
             /// @brief Returns the underlying SDL_Renderer.
             operator SDL_Renderer *() const noexcept;
 
@@ -61,10 +138,40 @@ namespace sdl3
             /// @brief Underlying SDL_Renderer.
             SDL_Renderer *m_renderer{};
 
+            /// @brief Surface headless renderers draw into. This has to outlive the renderer.
+            sdl3::Surface m_surface{nullptr, SDL_DestroySurface};
+
             /// @brief Logical width.
             int m_width{};
 
             /// @brief Logical height.
             int m_height{};
+
+            /// @brief Shadowed render state. Calls that wouldn't change anything are skipped.
+            sdl3::RenderState m_state{};
+
+            /// @brief Sprite batch textures are routed to.
+            sdl3::SpriteBatch m_batch{};
+
+            /// @brief Current render target.
+            sdl3::SharedTexture m_target = sdl3::Texture::NullTexture;
+
+            /// @brief Pooled render targets. These have to be destroyed before the renderer is.
+            sdl3::TargetPool m_targetPool{};
+
+            /// @brief Scratch vertex buffer primitives are built in.
+            std::vector<SDL_Vertex> m_primitiveVertices{};
+
+            /// @brief Scratch index buffer primitives are built in.
+            std::vector<int> m_primitiveIndices{};
+
+            /// @brief Adds an untextured quad to the primitive buffers.
+            /// @param corners Corners of the quad in order around it.
+            /// @param color Color of the quad.
+            void add_primitive_quad(const SDL_FPoint (&corners)[4], SDL_FColor color);
+
+            /// @brief Renders the primitive buffers in one geometry call and clears them.
+            /// @return True on success. False on failure.
+            bool submit_primitives();
     };
 }
\ No newline at end of file
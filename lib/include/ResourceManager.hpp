@@ -1,8 +1,11 @@
 #pragma once
 
 #include "Font.hpp"
+#include "MappedFile.hpp"
 #include "Texture.hpp"
+#include "TextureLoader.hpp"
 
+#include <concepts>
 #include <map>
 #include <memory>
 #include <string>
@@ -45,8 +48,8 @@ namespace sdl3
                     // Create and load the resource.
                     auto resource = std::make_shared<ResourceType>(std::forward<Args>(args)...);
 
-                    // Map.
-                    resourceMap.try_emplace(std::string{resourceName}, resource);
+                    // Map. An expired entry for the same name has to be replaced or nothing would be shared after it.
+                    resourceMap.insert_or_assign(std::string{resourceName}, resource);
 
                     return resource;
                 }
@@ -54,6 +57,42 @@ namespace sdl3
                 return nullptr;
             }
 
+            /// @brief Starts loading a texture in the background. Only available for textures.
+            /// @param resourceName Name the texture is mapped to.
+            /// @param texturePath Path of the image to load.
+            /// @return Handle to the texture. This is ready right away if the texture was already loaded.
+            static sdl3::AsyncTexture load_resource_async(std::string_view resourceName, std::string_view texturePath)
+                requires std::same_as<ResourceType, sdl3::Texture>
+            {
+                // Already loaded.
+                auto &resourceMap = ResourceManager::get_instance().m_resourceMap;
+                auto findResource = resourceMap.find(resourceName);
+                if (findResource != resourceMap.end() && !findResource->second.expired())
+                {
+                    return sdl3::AsyncTexture{findResource->second.lock()};
+                }
+
+                return sdl3::TextureLoader::load(resourceName, texturePath);
+            }
+
+            /// @brief Maps a resource that was created elsewhere unless a live one is already mapped to the name.
+            /// @param resourceName Name to map the resource to.
+            /// @param resource Resource to map.
+            /// @return Whichever resource ends up mapped to the name.
+            static std::shared_ptr<ResourceType> insert_resource(std::string_view resourceName,
+                                                                 std::shared_ptr<ResourceType> resource)
+            {
+                auto &resourceMap = ResourceManager::get_instance().m_resourceMap;
+                auto findResource = resourceMap.find(resourceName);
+                if (findResource != resourceMap.end() && !findResource->second.expired())
+                {
+                    return findResource->second.lock();
+                }
+
+                resourceMap.insert_or_assign(std::string{resourceName}, resource);
+                return resource;
+            }
+
         private:
             // clang-format off
             /// @brief Struct for string view hashing.
@@ -110,4 +149,7 @@ namespace sdl3
 
     /// @brief Definition for the FontManager.
     using FontManager = sdl3::ResourceManager<sdl3::Font>;
+
+    /// @brief Definition for the manager of mapped files. Every font size loaded from the same file shares one mapping.
+    using MappedFileManager = sdl3::ResourceManager<sdl3::MappedFile>;
 }
\ No newline at end of file
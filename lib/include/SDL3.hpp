@@ -1,13 +1,24 @@
 #pragma once
 
 #include "CoreComponent.hpp"
+#include "DrawList.hpp"
 #include "Font.hpp"
+#include "FramePacer.hpp"
 #include "GamepadManager.hpp"
 #include "Keyboard.hpp"
+#include "MappedFile.hpp"
 #include "Mouse.hpp"
+#include "ParticleSystem.hpp"
+#include "RenderState.hpp"
+#include "RenderStats.hpp"
 #include "Renderer.hpp"
 #include "ResourceManager.hpp"
+#include "SpriteBatch.hpp"
+#include "TargetPool.hpp"
+#include "TextLabel.hpp"
 #include "Texture.hpp"
+#include "TextureLoader.hpp"
+#include "Tilemap.hpp"
 #include "Timer.hpp"
 #include "Window.hpp"
 
@@ -28,6 +39,10 @@ namespace sdl3
             /// @brief Constructor. Initializes SDL3 and freetype.
             SDL3();
 
+            /// @brief Initializes only the SDL subsystems passed. Headless tools can skip video and audio entirely.
+            /// @param initFlags Subsystems to initialize.
+            SDL3(SDL_InitFlags initFlags);
+
             /// @brief Destructor. Quits SDL.
             ~SDL3();
 
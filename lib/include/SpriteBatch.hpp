@@ -0,0 +1,108 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <span>
+#include <vector>
+
+namespace sdl3
+{
+    /// @brief Collects textured geometry for a frame and submits it in as few SDL_RenderGeometry calls as possible.
+    class SpriteBatch
+    {
+        public:
+            /// @brief How queued geometry is ordered when the batch is flushed.
+            enum class SortMode
+            {
+                /// @brief Keeps submission order. Only neighboring submissions sharing a texture are merged.
+                Submission,
+
+                /// @brief Groups everything by texture. Only safe when overlapping sprites don't care about order.
+                Texture
+            };
+
+            // No copying or moving.
+            SpriteBatch(const SpriteBatch &)            = delete;
+            SpriteBatch(SpriteBatch &&)                 = delete;
+            SpriteBatch &operator=(const SpriteBatch &) = delete;
+            SpriteBatch &operator=(SpriteBatch &&)      = delete;
+
+            /// @brief Default constructor.
+            SpriteBatch() = default;
+
+            /// @brief Starts collecting geometry.
+            /// @param renderer Renderer the batch is flushed to.
+            /// @param sortMode How to order the geometry when flushing.
+            void begin(SDL_Renderer *renderer, SpriteBatch::SortMode sortMode);
+
+            /// @brief Flushes everything queued and stops collecting.
+            /// @return True on success. False on failure.
+            bool end();
+
+            /// @brief Submits everything queued so far without ending the batch.
+            /// @return True on success. False on failure.
+            bool flush();
+
+            /// @brief Returns whether or not the batch is currently collecting.
+            bool is_active() const noexcept;
+
+            /// @brief Queues a textured quad.
+            /// @param texture Texture to render with.
+            /// @param textureWidth Width of the texture. Used for texture coordinates.
+            /// @param textureHeight Height of the texture. Used for texture coordinates.
+            /// @param sourceRect Part of the texture to render.
+            /// @param destRect Where to render it.
+            /// @param color Color of the quad's vertices.
+            void add_quad(SDL_Texture *texture,
+                          float textureWidth,
+                          float textureHeight,
+                          const SDL_FRect &sourceRect,
+                          const SDL_FRect &destRect,
+                          SDL_FColor color);
+
+            /// @brief Queues arbitrary triangles.
+            /// @param texture Texture to render with. Can be nullptr for untextured geometry.
+            /// @param vertices Vertices of the triangles.
+            /// @param indices Indices into vertices. Every three form a triangle.
+            /// @param colorMod Color the vertex colors are multiplied by.
+            void add_geometry(SDL_Texture *texture,
+                              std::span<const SDL_Vertex> vertices,
+                              std::span<const int> indices,
+                              SDL_FColor colorMod);
+
+        private:
+            // clang-format off
+            /// @brief A single submission to the batch.
+            struct Command
+            {
+                SDL_Texture *texture{};
+                size_t firstVertex{};
+                size_t vertexCount{};
+                size_t firstIndex{};
+                size_t indexCount{};
+            };
+            // clang-format on
+
+            /// @brief Renderer to flush to.
+            SDL_Renderer *m_renderer{};
+
+            /// @brief Whether or not the batch is collecting.
+            bool m_active{};
+
+            /// @brief Sort mode for the current batch.
+            SpriteBatch::SortMode m_sortMode{};
+
+            /// @brief Every vertex queued this batch.
+            std::vector<SDL_Vertex> m_vertices{};
+
+            /// @brief Every index queued this batch. These are relative to the command's first vertex.
+            std::vector<int> m_indices{};
+
+            /// @brief Commands in submission order.
+            std::vector<SpriteBatch::Command> m_commands{};
+
+            /// @brief Scratch vertex buffer used to build each draw call.
+            std::vector<SDL_Vertex> m_drawVertices{};
+
+            /// @brief Scratch index buffer used to build each draw call.
+            std::vector<int> m_drawIndices{};
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "Texture.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace sdl3
+{
+    /// @brief Pool of render target textures reused by size class so they aren't created and destroyed constantly.
+    class TargetPool
+    {
+        public:
+            // No copying or moving.
+            TargetPool(const TargetPool &)            = delete;
+            TargetPool(TargetPool &&)                 = delete;
+            TargetPool &operator=(const TargetPool &) = delete;
+            TargetPool &operator=(TargetPool &&)      = delete;
+
+            /// @brief Default constructor.
+            TargetPool() = default;
+
+            /// @brief Returns a target at least width x height. Its contents are undefined.
+            /// @param width Minimum width of the target.
+            /// @param height Minimum height of the target.
+            /// @return Target texture. This can be bigger than requested. nullptr on failure.
+            sdl3::SharedTexture acquire(int width, int height);
+
+            /// @brief Hands a target acquired from the pool back to it. This is safe while draws of the target are still
+            ///        batched. Targets handed out again are flushed once they're set as the render target, and targets
+            ///        dropped because the class is full flush the batch before they're destroyed.
+            /// @param target Target to return. The caller's pointer is reset.
+            void release(sdl3::SharedTexture &target);
+
+            /// @brief Destroys every pooled target. This needs to happen before the renderer is destroyed.
+            void clear();
+
+        private:
+            /// @brief Smallest size class. Tiny labels all share this one.
+            static constexpr int MIN_CLASS_SIZE = 32;
+
+            /// @brief Most idle targets kept per size class. Anything past this is destroyed when released.
+            static constexpr size_t MAX_IDLE_PER_CLASS = 16;
+
+            /// @brief Idle targets by size class.
+            std::unordered_map<uint64_t, std::vector<sdl3::SharedTexture>> m_idleTargets{};
+
+            /// @brief Rounds the dimension passed up to its size class.
+            static int get_class_size(int size) noexcept;
+
+            /// @brief Returns the key of the size class passed.
+            static uint64_t get_class_key(int classWidth, int classHeight) noexcept;
+    };
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "Font.hpp"
+#include "Texture.hpp"
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <string_view>
+
+namespace sdl3
+{
+    /// @brief Forward declaration for the renderer.
+    class Renderer;
+
+    /// @brief Text that's rendered once to a target texture and drawn as a single quad after that. It's only rendered
+    /// again when the text, color or font changes.
+    class TextLabel
+    {
+        public:
+            // No copying. Moving is fine.
+            TextLabel(const TextLabel &)            = delete;
+            TextLabel(TextLabel &&)                 = default;
+            TextLabel &operator=(const TextLabel &) = delete;
+            TextLabel &operator=(TextLabel &&)      = default;
+
+            /// @brief Default constructor.
+            TextLabel() = default;
+
+            /// @brief Creates a label.
+            /// @param font Font to render the text with.
+            /// @param text UTF-8 text of the label.
+            /// @param color Color of the text.
+            TextLabel(sdl3::SharedFont font, std::string_view text, SDL_Color color);
+
+            /// @brief Returns the target to the renderer's pool.
+            ~TextLabel();
+
+            /// @brief Initializes the label class for usage.
+            /// @param renderer Renderer labels are rendered with. Targets come from its pool.
+            static void initialize(sdl3::Renderer &renderer);
+
+            /// @brief Sets the text of the label.
+            /// @param text UTF-8 text.
+            void set_text(std::string_view text);
+
+            /// @brief Sets the color of the text.
+            /// @param color Color to render the text with.
+            void set_color(SDL_Color color);
+
+            /// @brief Sets the font the text is rendered with.
+            /// @param font Font to use.
+            void set_font(sdl3::SharedFont font);
+
+            /// @brief Forces the label to be rendered again next time. This is needed after SDL_EVENT_RENDER_TARGETS_RESET.
+            void invalidate() noexcept;
+
+            /// @brief Returns the text of the label.
+            std::string_view get_text() const noexcept;
+
+            /// @brief Returns the width of the text in pixels.
+            int get_width() const noexcept;
+
+            /// @brief Returns the height of the text in pixels.
+            int get_height() const noexcept;
+
+            /// @brief Renders the label, rendering the text to the target first if it changed.
+            /// @param x X coordinate to render to.
+            /// @param y Y coordinate to render to.
+            /// @return True on success. False on failure.
+            bool render(int x, int y);
+
+        private:
+            /// @brief Space around the text in the target. Glyphs can hang a little outside of the measured box.
+            static constexpr int PADDING = 2;
+
+            /// @brief Font used.
+            sdl3::SharedFont m_font{};
+
+            /// @brief Text of the label.
+            std::string m_text{};
+
+            /// @brief Color of the text.
+            SDL_Color m_color{};
+
+            /// @brief Width of the text.
+            int m_width{};
+
+            /// @brief Height of the text.
+            int m_height{};
+
+            /// @brief Target the text is rendered to.
+            sdl3::SharedTexture m_target{};
+
+            /// @brief Whether or not the target needs to be rendered again.
+            bool m_dirty = true;
+
+            /// @brief Renderer used to render the text to the target.
+            static inline sdl3::Renderer *sm_renderer{};
+
+            /// @brief Measures the text with the current font.
+            void update_size();
+
+            /// @brief Renders the text to the target, grabbing one of the right size from the pool first.
+            /// @return True on success. False on failure.
+            bool bake();
+    };
+}
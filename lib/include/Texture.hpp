@@ -1,12 +1,17 @@
 #pragma once
 
+#include "AtlasPacker.hpp"
 #include "CoreComponent.hpp"
+#include "SpriteBatch.hpp"
 #include "Surface.hpp"
 
 #include <SDL3/SDL.h>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <span>
+#include <vector>
 
 namespace sdl3
 {
@@ -19,6 +24,18 @@ namespace sdl3
     /// @brief This makes things easier to type.
     using SharedTexture = std::shared_ptr<Texture>;
 
+    // clang-format off
+    /// @brief View over pixels locked in a texture's staging buffer.
+    struct LockedPixels
+    {
+        /// @brief Pixels starting at the first pixel of the locked area. Empty if the lock failed.
+        std::span<uint8_t> pixels{};
+
+        /// @brief Number of bytes between rows.
+        int pitch{};
+    };
+    // clang-format on
+
     /// @brief SDL_Texture wrapper class.
     class Texture : public sdl3::CoreComponent
     {
@@ -32,37 +49,82 @@ namespace sdl3
             /// @brief Creates and loads a texture from the path passed.
             /// @param renderer Pointer to the renderer used by the texture.
             /// @param texturePath Path to the texture to load.
+            /// @note Images under the atlas threshold are packed into a shared atlas page instead of getting their own texture.
             Texture(std::string_view texturePath);
 
             /// @brief Creates a texture from the surface passed.
             /// @param renderer Pointer to the renderer used by the texture.
-            /// @param surface Surface to create the texture from.
+            /// @param surface Surface to create the texture from. This is packed into the atlas if it's small enough.
             Texture(sdl3::Surface &surface);
 
+            /// @brief Creates a texture from a surface prepare_surface already converted. The pixels are uploaded as they are.
+            /// @param surface Surface in the native format. This is packed into the atlas if it's small enough.
+            /// @param premultiplied Whether or not prepare_surface premultiplied the surface's alpha.
+            Texture(sdl3::Surface &surface, bool premultiplied);
+
             /// @brief Creates a new texture using image data passed.
             /// @param data Data to use to create the texture.
             Texture(std::span<const uint8_t> data);
 
-            /// @brief Creates a blank texture using the flags passed.
+            /// @brief Creates a blank texture in the renderer's native format using the flags passed.
             /// @param renderer Pointer to the renderer used by the texture.
             /// @param width Width of the texture.
             /// @param height Height of the texture.
             /// @param accessFlags Access flags.
             Texture(int width, int height, SDL_TextureAccess accessFlags);
 
+            /// @brief Creates a blank texture in the pixel format passed.
+            /// @param width Width of the texture.
+            /// @param height Height of the texture.
+            /// @param format Pixel format of the texture.
+            /// @param accessFlags Access flags.
+            Texture(int width, int height, SDL_PixelFormat format, SDL_TextureAccess accessFlags);
+
             /// @brief Frees the texture once it's finished.
             ~Texture();
 
             /// @brief Initializes the texture class for usage.
-            /// @param renderer Renderer to use.
+            /// @param renderer Renderer to use. Render calls are routed into its sprite batch while it's active.
+            /// @note This also picks the native format surfaces are converted to from the renderer's preferred formats.
             static void initialize(sdl3::Renderer &renderer);
 
+            /// @brief Returns the 32 bit format textures created from surfaces are converted to.
+            static SDL_PixelFormat get_native_format() noexcept;
+
+            /// @brief Sets whether or not textures created from surfaces from here on have their alpha premultiplied.
+            /// @param premultiply Whether or not to premultiply. Premultiplied textures use SDL_BLENDMODE_BLEND_PREMULTIPLIED.
+            static void set_premultiply_alpha(bool premultiply) noexcept;
+
+            /// @brief Returns whether or not textures created from surfaces have their alpha premultiplied.
+            static bool get_premultiply_alpha() noexcept;
+
+            /// @brief Converts a surface to the native format, premultiplying its alpha if asked to. Nothing here touches the
+            ///        renderer, so workers can call this to keep the conversion off the render thread.
+            /// @param surface Surface to convert. It's replaced by the converted surface.
+            /// @param premultiply Whether or not to premultiply the alpha.
+            /// @return True on success. False on failure.
+            static bool prepare_surface(sdl3::Surface &surface, bool premultiply);
+
+            /// @brief Sets the size images loaded from paths have to fit within to be packed into shared atlas pages.
+            /// @param maxSize Maximum width and height of atlased images. 0 disables the atlas.
+            static void set_atlas_threshold(int maxSize) noexcept;
+
+            /// @brief Returns whether or not the renderer can create textures in the format passed.
+            /// @param format Format to check.
+            static bool supports_format(SDL_PixelFormat format);
+
             /// @brief Returns the width of the sprite.
             int get_width() const noexcept;
 
             /// @brief Returns the height of the sprite.
             int get_height() const noexcept;
 
+            /// @brief Returns whether or not the texture's alpha is premultiplied.
+            bool is_premultiplied() const noexcept;
+
+            /// @brief Returns an id unique to the underlying SDL_Texture. Atlased textures share their page's id.
+            uint32_t get_id() const noexcept;
+
             /// @brief Set's the alpha mod of the texture.
             /// @param alpha Alpha to render with.
             /// @return True on success. False on failure.
@@ -75,9 +137,53 @@ namespace sdl3
 
             /// @brief Sets the scale mode for the text.
             /// @param scaleMode Scale mode to set to.
+            /// @note Atlased textures share their scale and blend modes with the rest of the page. Calls that wouldn't change
+            ///       anything are skipped.
             /// @return True on success. False on failure.
             bool set_scale_mode(SDL_ScaleMode scaleMode);
 
+            /// @brief Sets the blend mode for the texture.
+            /// @param blendMode Blend mode to set to.
+            /// @return True on success. False on failure.
+            bool set_blend_mode(SDL_BlendMode blendMode);
+
+            /// @brief Sets the palette of an indexed texture.
+            /// @param colors Colors of the palette.
+            /// @return True on success. False on failure or if the SDL version doesn't support texture palettes.
+            bool set_palette(std::span<const SDL_Color> colors);
+
+            /// @brief Updates a region of the texture with the pixel data passed. The staging buffer is kept in step if the
+            ///        texture has one.
+            /// @param rect Region to update. nullptr updates the entire texture.
+            /// @param pixels Pixel data in the format of the texture.
+            /// @param pitch Number of bytes per row in pixels.
+            /// @return True on success. False on failure.
+            bool update(const SDL_Rect *rect, const void *pixels, int pitch);
+
+            /// @brief Locks part of the texture's staging buffer for writing. Changes are uploaded when the texture is next
+            ///        rendered or when the frame ends.
+            /// @param rect Area to lock. nullptr locks the whole texture.
+            /// @return View over the locked area. The staging buffer starts out cleared and never reads back the texture.
+            sdl3::LockedPixels lock(const SDL_Rect *rect = nullptr);
+
+            /// @brief Copies tightly packed pixels into the staging buffer. They're uploaded like changes made through lock.
+            /// @param rect Area to update.
+            /// @param pixels Pixels in the format of the texture. Rows are rect.w pixels wide with no padding.
+            /// @return True on success. False if rect is outside of the texture or pixels is too small.
+            bool update(const SDL_Rect &rect, std::span<const uint8_t> pixels);
+
+            /// @brief Uploads the changed areas of the staging buffer now.
+            /// @return True on success. False on failure.
+            bool upload_changes();
+
+            /// @brief Uploads the changes of every texture that has them. The renderer calls this at the end of each frame.
+            static bool upload_all_changes();
+
+            /// @brief Submits whatever the sprite batch has queued. Textures call this before destroying their SDL texture,
+            ///        since the batch only holds the raw pointer.
+            /// @return True on success. False on failure.
+            static bool flush_batch();
+
             /// @brief Renders the texture to the target passed at the coordinates passed.
             /// @param target Target to render to.
             /// @param x X coordinate.
@@ -125,20 +231,197 @@ namespace sdl3
                                        int sourceWidth,
                                        int sourceHeight);
 
+            /// @brief Renders triangles using the texture.
+            /// @param vertices Vertices to render.
+            /// @param indices Indices into vertices. Every three form a triangle.
+            /// @return True on success. False on failure.
+            bool render_geometry(std::span<const SDL_Vertex> vertices, std::span<const int> indices);
+
             /// @brief Operator that allows passing as a plain, SDL_Texture.
             operator SDL_Texture *() const noexcept;
 
         private:
+            // clang-format off
+            /// @brief Shared page small images are packed into.
+            struct AtlasPage
+            {
+                std::weak_ptr<sdl3::Texture> texture{};
+                sdl3::AtlasPacker packer;
+                bool premultiplied{};
+            };
+            // clang-format on
+
+            /// @brief Width and height of atlas pages.
+            static constexpr int ATLAS_PAGE_SIZE = 1024;
+
+            /// @brief Most separate dirty areas tracked before they're collapsed into their bounding box. That only happens
+            ///        once the whole staging buffer has been written.
+            static constexpr size_t MAX_DIRTY_RECTS = 8;
+
+            /// @brief Transparent padding between atlased images so filtering doesn't pick up their neighbors.
+            static constexpr int ATLAS_PADDING = 2;
+
             /// @brief Pointer to the underlying SDL_Texture.
             SDL_Texture *m_texture{};
 
+            /// @brief Id of the texture. Used for sort keys.
+            uint32_t m_id = ++sm_nextId;
+
+            /// @brief Palette for indexed textures. The texture doesn't own it, so it's freed with the texture.
+            SDL_Palette *m_palette{};
+
+            /// @brief Atlas page this texture lives in. Nullptr if the texture owns its SDL_Texture.
+            sdl3::SharedTexture m_atlasPage{};
+
+            /// @brief Offset of the texture within its atlas page.
+            float m_atlasX{};
+
+            /// @brief Offset of the texture within its atlas page.
+            float m_atlasY{};
+
             /// @brief Width of the texture.
             float m_width{};
 
             /// @brief Height of the texture.
             float m_height{};
 
+            /// @brief Color mod requested for the texture.
+            SDL_Color m_colorMod{0xFF, 0xFF, 0xFF, 0xFF};
+
+            /// @brief Whether or not the pixels have their alpha premultiplied.
+            bool m_premultiplied{};
+
+            /// @brief CPU copy of the pixels written through lock and update. Allocated the first time either is used.
+            std::vector<uint8_t> m_staging{};
+
+            /// @brief Bytes per row in m_staging.
+            int m_stagingPitch{};
+
+            /// @brief Areas of m_staging that haven't been uploaded yet. These can overlap until m_stagingComplete is set.
+            std::vector<SDL_Rect> m_dirtyRects{};
+
+            /// @brief Whether or not every pixel of m_staging has been written. Until it has, dirty areas are never merged
+            ///        across pixels that weren't.
+            bool m_stagingComplete{};
+
+            /// @brief Scale mode set on the SDL_Texture. std::nullopt until it's been set through the wrapper.
+            std::optional<SDL_ScaleMode> m_scaleMode{};
+
+            /// @brief Blend mode set on the SDL_Texture. std::nullopt until it's been set through the wrapper.
+            std::optional<SDL_BlendMode> m_blendMode{};
+
+            /// @brief Color mod currently set on the SDL_Texture. Batched rendering carries the mod in the vertices instead.
+            SDL_Color m_appliedColorMod{0xFF, 0xFF, 0xFF, 0xFF};
+
             /// @brief Shared pointer to the renderer (to make things easier to work with).
             static inline SDL_Renderer *sm_renderer{};
+
+            /// @brief Sprite batch render calls are routed into while it's active.
+            static inline sdl3::SpriteBatch *sm_batch{};
+
+            /// @brief Format surfaces are converted to before they're uploaded.
+            static inline SDL_PixelFormat sm_nativeFormat = SDL_PIXELFORMAT_ABGR8888;
+
+            /// @brief Whether or not surfaces have their alpha premultiplied when they're converted.
+            static inline bool sm_premultiplyAlpha{};
+
+            /// @brief Scratch buffer surfaces are converted into.
+            static inline std::vector<uint32_t> sm_convertBuffer{};
+
+            /// @brief Last texture id handed out.
+            static inline uint32_t sm_nextId{};
+
+            /// @brief Maximum width and height of images packed into the atlas. 0 means the atlas is disabled.
+            static inline int sm_atlasThreshold{};
+
+            /// @brief Atlas pages. These are weak so pages are freed once nothing packed into them is alive.
+            static inline std::vector<Texture::AtlasPage> sm_atlasPages{};
+
+            /// @brief Textures with changes waiting to be uploaded.
+            static inline std::vector<sdl3::Texture *> sm_dirtyTextures{};
+
+            /// @brief Scratch buffer for remapping geometry onto atlas pages.
+            static inline std::vector<SDL_Vertex> sm_atlasVertices{};
+
+            /// @brief Creates the texture from the surface passed, packing it into the atlas if it's small enough.
+            /// @param surface Surface to create the texture from.
+            /// @return True on success. False on failure.
+            bool create_from_surface(SDL_Surface *surface);
+
+            /// @brief Creates the texture from pixels already in the native format, packing it into the atlas if it's small
+            ///        enough.
+            /// @param pixels Pixels in the native format.
+            /// @param pitch Number of bytes per row in pixels.
+            /// @param width Width of the image.
+            /// @param height Height of the image.
+            /// @param premultiplied Whether or not the pixels have their alpha premultiplied.
+            /// @return True on success. False on failure.
+            bool create_from_pixels(const void *pixels, int pitch, int width, int height, bool premultiplied);
+
+            /// @brief Packs the pixels passed into an atlas page and points this texture at it.
+            /// @param pixels Pixels in the native format.
+            /// @param pitch Number of bytes per row in pixels.
+            /// @param width Width of the image.
+            /// @param height Height of the image.
+            /// @param premultiplied Whether or not the pixels have their alpha premultiplied. Pages only hold one kind.
+            /// @return True on success. False if it couldn't be packed.
+            bool pack_into_atlas(const void *pixels, int pitch, int width, int height, bool premultiplied);
+
+            /// @brief Gets the surface's pixels into the native format, premultiplying them if that's enabled.
+            /// @param surface Surface to convert.
+            /// @param pitch Set to the number of bytes per row in the pixels returned.
+            /// @return Converted pixels. These are the surface's own if they already match. nullptr on failure.
+            static const void *prepare_pixels(SDL_Surface *surface, int &pitch);
+
+            /// @brief Converts the surface's pixels into the native format in the buffer passed.
+            /// @param surface Surface to convert.
+            /// @param dest Buffer to write to. It needs room for the whole surface.
+            /// @param destPitch Number of pixels per row in dest.
+            /// @param premultiply Whether or not to premultiply the alpha.
+            /// @return True on success. False if the surface couldn't be converted.
+            static bool convert_surface(SDL_Surface *surface, uint32_t *dest, int destPitch, bool premultiply);
+
+            /// @brief Allocates the staging buffer if it hasn't been already.
+            /// @return True if the staging buffer is ready. False on failure.
+            bool prepare_staging();
+
+            /// @brief Clips the rect passed to the texture. nullptr becomes the whole texture.
+            /// @param rect Rect to clip.
+            /// @return Clipped rect. std::nullopt if nothing is left of it.
+            std::optional<SDL_Rect> clip_to_texture(const SDL_Rect *rect) const noexcept;
+
+            /// @brief Uploads pixels straight to the SDL_Texture. Atlased textures are offset to their part of the page.
+            /// @param rect Area to update. nullptr updates the entire texture.
+            /// @param pixels Pixel data in the format of the texture.
+            /// @param pitch Number of bytes per row in pixels.
+            /// @return True on success. False on failure.
+            bool upload_rect(const SDL_Rect *rect, const void *pixels, int pitch);
+
+            /// @brief Records a write to the staging buffer. Once one covers the whole texture, all of staging is valid.
+            /// @param rect Area written.
+            void mark_written(const SDL_Rect &rect) noexcept;
+
+            /// @brief Adds the rect passed to the dirty areas, merging it with any it touches where that's safe.
+            /// @param rect Rect to add.
+            void mark_dirty(SDL_Rect rect);
+
+            /// @brief Returns the texture that owns the SDL_Texture. This is the atlas page for atlased textures.
+            sdl3::Texture &get_owner() noexcept;
+
+            /// @brief Returns the color mod to render with. Premultiplied textures need the alpha mod in the color too.
+            SDL_Color get_render_color_mod() const noexcept;
+
+            /// @brief Returns the color mod as a vertex color.
+            SDL_FColor get_vertex_color() const noexcept;
+
+            /// @brief Makes sure the SDL_Texture's mods match the color passed.
+            /// @param colorMod Color and alpha mod to set.
+            bool apply_color_mod(SDL_Color colorMod);
+
+            /// @brief Renders the part of the texture passed. Goes through the sprite batch if it's active.
+            /// @param sourceRect Part of the texture to render.
+            /// @param destRect Where to render it.
+            /// @return True on success. False on failure.
+            bool submit(const SDL_FRect &sourceRect, const SDL_FRect &destRect);
     };
 }
\ No newline at end of file
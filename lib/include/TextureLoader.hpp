@@ -0,0 +1,115 @@
+#pragma once
+#include "Surface.hpp"
+#include "Texture.hpp"
+
+#include <SDL3/SDL.h>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sdl3
+{
+    /// @brief Forward so the handle can be declared first.
+    class TextureLoader;
+
+    /// @brief Handle to a texture being loaded in the background. Only check it from the render thread.
+    class AsyncTexture
+    {
+        public:
+            /// @brief Default constructor. The handle is empty and never becomes ready.
+            AsyncTexture() = default;
+
+            /// @brief Creates a handle for a texture that was already loaded.
+            /// @param texture Texture to hand back.
+            AsyncTexture(sdl3::SharedTexture texture);
+
+            /// @brief Returns whether or not the load has finished. This is true for failed loads too.
+            bool is_ready() const noexcept;
+
+            /// @brief Returns whether or not the load failed.
+            bool has_failed() const noexcept;
+
+            /// @brief Returns the texture. nullptr if it isn't ready or the load failed.
+            sdl3::SharedTexture get() const noexcept;
+
+        private:
+            // Loader needs to build these.
+            friend class sdl3::TextureLoader;
+
+            // clang-format off
+            /// @brief State shared between the handle, the worker decoding it and the upload queue.
+            struct LoadState
+            {
+                std::string name{};
+                std::string path{};
+                sdl3::Surface surface{nullptr, SDL_DestroySurface};
+                sdl3::SharedTexture texture{};
+                bool premultiplied{};
+                bool finished{};
+            };
+            // clang-format on
+
+            /// @brief State of the load.
+            std::shared_ptr<AsyncTexture::LoadState> m_state{};
+
+            /// @brief Creates a handle for the load passed.
+            /// @param state State of the load.
+            AsyncTexture(std::shared_ptr<AsyncTexture::LoadState> state);
+    };
+
+    /// @brief Decodes images on the shared thread pool and uploads them on the render thread under a time budget.
+    class TextureLoader final
+    {
+        public:
+            // Everything here is static.
+            TextureLoader() = delete;
+
+            /// @brief Starts loading the image passed. Loads already in flight under the same name are shared.
+            /// @param name Name the texture is mapped to in the TextureManager once it's uploaded.
+            /// @param texturePath Path of the image to load.
+            /// @return Handle to the load.
+            static sdl3::AsyncTexture load(std::string_view name, std::string_view texturePath);
+
+            /// @brief Uploads decoded images until the budget runs out. The renderer calls this at the start of every frame.
+            /// @return Number of textures finished.
+            static size_t upload_pending();
+
+            /// @brief Sets how long upload_pending can spend uploading per frame. At least one texture is always uploaded.
+            /// @param milliseconds Budget in milliseconds.
+            static void set_upload_budget(double milliseconds) noexcept;
+
+            /// @brief Returns the number of loads that haven't finished yet.
+            static size_t get_pending_count() noexcept;
+
+        private:
+            /// @brief Makes stuff easier to type.
+            using SharedLoadState = std::shared_ptr<AsyncTexture::LoadState>;
+
+            /// @brief Loads that haven't been uploaded yet, mapped by name.
+            static inline std::unordered_map<std::string, SharedLoadState> sm_inFlight{};
+
+            /// @brief Loads the workers have finished decoding.
+            static inline std::vector<SharedLoadState> sm_decoded{};
+
+            /// @brief Guards sm_decoded.
+            static inline std::mutex sm_decodedMutex{};
+
+            /// @brief Loads waiting on the render thread to be uploaded.
+            static inline std::deque<SharedLoadState> sm_uploads{};
+
+            /// @brief Upload budget in nanoseconds.
+            static inline uint64_t sm_uploadBudget = 2000000;
+
+            /// @brief Decodes the image for the load passed. This runs on a worker.
+            /// @param state Load to decode.
+            static void decode(const SharedLoadState &state);
+
+            /// @brief Creates the texture for the load passed and maps it in the TextureManager.
+            /// @param state Load to finish.
+            static void finish(AsyncTexture::LoadState &state);
+    };
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace sdl3
+{
+    /// @brief Fixed size pool of worker threads for background jobs.
+    class ThreadPool final
+    {
+        public:
+            /// @brief Makes stuff easier to type.
+            using Job = std::function<void()>;
+
+            // No copying or moving.
+            ThreadPool(const ThreadPool &)            = delete;
+            ThreadPool(ThreadPool &&)                 = delete;
+            ThreadPool &operator=(const ThreadPool &) = delete;
+            ThreadPool &operator=(ThreadPool &&)      = delete;
+
+            /// @brief Starts the number of workers passed.
+            /// @param workerCount Number of worker threads. 0 uses one less than the number of hardware threads.
+            ThreadPool(size_t workerCount = 0);
+
+            /// @brief Finishes the jobs already queued and joins the workers.
+            ~ThreadPool();
+
+            /// @brief Returns the pool shared by the library's background jobs.
+            static ThreadPool &get_shared();
+
+            /// @brief Queues a job to be run on a worker.
+            /// @param job Job to run.
+            void submit(ThreadPool::Job job);
+
+            /// @brief Returns the number of worker threads.
+            size_t get_worker_count() const noexcept;
+
+        private:
+            /// @brief Worker threads.
+            std::vector<std::jthread> m_workers{};
+
+            /// @brief Jobs waiting for a worker.
+            std::queue<ThreadPool::Job> m_jobs{};
+
+            /// @brief Guards the job queue.
+            std::mutex m_jobMutex{};
+
+            /// @brief Wakes the workers when a job is queued or the pool is shutting down.
+            std::condition_variable m_jobCondition{};
+
+            /// @brief Whether or not the workers should exit once the queue is empty.
+            bool m_shutdown{};
+
+            /// @brief Worker thread loop.
+            void worker_loop();
+    };
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include "Texture.hpp"
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <vector>
+
+namespace sdl3
+{
+    /// @brief Forward declaration for the renderer.
+    class Renderer;
+
+    /// @brief Grid of tiles from a tileset. The map is split into chunks that are each rendered once to a target texture,
+    /// so drawing the map only costs one quad per chunk in view. Chunks are only rendered again when their tiles change.
+    class Tilemap
+    {
+        public:
+            /// @brief Tile index that's left empty.
+            static constexpr uint16_t EMPTY_TILE = UINT16_MAX;
+
+            // No copying. Moving is fine.
+            Tilemap(const Tilemap &)            = delete;
+            Tilemap(Tilemap &&)                 = default;
+            Tilemap &operator=(const Tilemap &) = delete;
+            Tilemap &operator=(Tilemap &&)      = default;
+
+            /// @brief Default constructor.
+            Tilemap() = default;
+
+            /// @brief Creates an empty map.
+            /// @param tileset Texture holding the tiles. Tiles are numbered left to right, then top to bottom.
+            /// @param tileWidth Width of a tile in pixels.
+            /// @param tileHeight Height of a tile in pixels.
+            /// @param columns Width of the map in tiles.
+            /// @param rows Height of the map in tiles.
+            Tilemap(sdl3::SharedTexture tileset, int tileWidth, int tileHeight, int columns, int rows);
+
+            /// @brief Returns the chunk targets to the renderer's pool.
+            ~Tilemap();
+
+            /// @brief Initializes the tilemap class for usage.
+            /// @param renderer Renderer chunks are rendered with. Targets come from its pool.
+            static void initialize(sdl3::Renderer &renderer);
+
+            /// @brief Sets a tile. The chunk it's in is rendered again the next time it's in view.
+            /// @param column Column of the tile.
+            /// @param row Row of the tile.
+            /// @param tile Index of the tile in the tileset. EMPTY_TILE clears it.
+            /// @return True on success. False if the tile is outside of the map.
+            bool set_tile(int column, int row, uint16_t tile);
+
+            /// @brief Returns the tile at the position passed. EMPTY_TILE if it's outside of the map.
+            /// @param column Column of the tile.
+            /// @param row Row of the tile.
+            uint16_t get_tile(int column, int row) const noexcept;
+
+            /// @brief Sets every tile in the map.
+            /// @param tile Index of the tile in the tileset.
+            void fill(uint16_t tile);
+
+            /// @brief Forces every chunk to be rendered again. This is needed after SDL_EVENT_RENDER_TARGETS_RESET.
+            void invalidate() noexcept;
+
+            /// @brief Returns the width of the map in tiles.
+            int get_columns() const noexcept;
+
+            /// @brief Returns the height of the map in tiles.
+            int get_rows() const noexcept;
+
+            /// @brief Renders the chunks that are in view, rendering any that changed to their targets first.
+            /// @param cameraX X coordinate in the map that lands on the left edge of the renderer's logical viewport.
+            /// @param cameraY Y coordinate in the map that lands on the top edge of the renderer's logical viewport.
+            /// @return True on success. False on failure.
+            bool render(int cameraX, int cameraY);
+
+        private:
+            /// @brief Width and height of a chunk in tiles.
+            static constexpr int CHUNK_TILES = 32;
+
+            /// @brief Most chunks holding a target at once. Chunks that went out of view longest ago give theirs up first.
+            static constexpr size_t MAX_BAKED_CHUNKS = 48;
+
+            // clang-format off
+            /// @brief Part of the map rendered to a single target.
+            struct Chunk
+            {
+                sdl3::SharedTexture target{};
+                uint64_t lastUse{};
+                bool dirty = true;
+                bool empty{};
+            };
+            // clang-format on
+
+            /// @brief Texture holding the tiles.
+            sdl3::SharedTexture m_tileset{};
+
+            /// @brief Width of a tile.
+            int m_tileWidth{};
+
+            /// @brief Height of a tile.
+            int m_tileHeight{};
+
+            /// @brief Width of the map in tiles.
+            int m_columns{};
+
+            /// @brief Height of the map in tiles.
+            int m_rows{};
+
+            /// @brief Width of the map in chunks.
+            int m_chunkColumns{};
+
+            /// @brief Height of the map in chunks.
+            int m_chunkRows{};
+
+            /// @brief Tile indices row by row.
+            std::vector<uint16_t> m_tiles{};
+
+            /// @brief Chunks row by row.
+            std::vector<Tilemap::Chunk> m_chunks{};
+
+            /// @brief Number of chunks holding a target.
+            size_t m_bakedCount{};
+
+            /// @brief Incremented every render. Chunks record it when they're drawn.
+            uint64_t m_useClock{};
+
+            /// @brief Renderer used to render chunks to their targets.
+            static inline sdl3::Renderer *sm_renderer{};
+
+            /// @brief Returns the area a chunk covers in map pixels.
+            /// @param chunkColumn Column of the chunk.
+            /// @param chunkRow Row of the chunk.
+            SDL_Rect get_chunk_area(int chunkColumn, int chunkRow) const noexcept;
+
+            /// @brief Renders the tiles of a chunk to its target, grabbing one from the pool first if it needs one.
+            /// @param chunkColumn Column of the chunk.
+            /// @param chunkRow Row of the chunk.
+            /// @return True on success. False on failure.
+            bool bake_chunk(int chunkColumn, int chunkRow);
+
+            /// @brief Gives the target of the chunk used longest ago back to the pool. Chunks drawn this render are kept.
+            void evict_chunk();
+
+            /// @brief Gives the chunk's target back to the pool.
+            /// @param chunk Chunk to release.
+            void release_chunk(Tilemap::Chunk &chunk);
+    };
+}
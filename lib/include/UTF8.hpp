@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+namespace sdl3::utf8
+{
+    /// @brief Codepoint returned for malformed sequences.
+    inline constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+    /// @brief Decodes the codepoint starting at offset and advances offset past it.
+    /// @param text Text to decode from.
+    /// @param offset Byte offset to decode at. This is advanced by the length of the sequence.
+    /// @return Decoded codepoint. REPLACEMENT_CHARACTER if the sequence is malformed.
+    inline char32_t decode_next(std::string_view text, size_t &offset) noexcept
+    {
+        const uint8_t lead = static_cast<uint8_t>(text[offset++]);
+
+        // Plain ASCII is by far the most common case.
+        if (lead < 0x80) { return lead; }
+
+        // Figure out how long the sequence is from the lead byte.
+        size_t length{};
+        char32_t codepoint{};
+        char32_t minimum{};
+        if ((lead & 0xE0) == 0xC0)
+        {
+            length    = 1;
+            codepoint = lead & 0x1F;
+            minimum   = 0x80;
+        }
+        else if ((lead & 0xF0) == 0xE0)
+        {
+            length    = 2;
+            codepoint = lead & 0x0F;
+            minimum   = 0x800;
+        }
+        else if ((lead & 0xF8) == 0xF0)
+        {
+            length    = 3;
+            codepoint = lead & 0x07;
+            minimum   = 0x10000;
+        }
+        else
+        {
+            return REPLACEMENT_CHARACTER;
+        }
+
+        // Continuation bytes. A bad one is left alone so it's decoded on its own next time.
+        for (size_t i = 0; i < length; i++)
+        {
+            if (offset >= text.length()) { return REPLACEMENT_CHARACTER; }
+
+            const uint8_t continuation = static_cast<uint8_t>(text[offset]);
+            if ((continuation & 0xC0) != 0x80) { return REPLACEMENT_CHARACTER; }
+
+            codepoint = (codepoint << 6) | (continuation & 0x3F);
+            ++offset;
+        }
+
+        // Overlong encodings, surrogates and anything past the unicode range are invalid.
+        const bool overlong  = codepoint < minimum;
+        const bool surrogate = codepoint >= 0xD800 && codepoint <= 0xDFFF;
+        if (overlong || surrogate || codepoint > 0x10FFFF) { return REPLACEMENT_CHARACTER; }
+
+        return codepoint;
+    }
+}
@@ -0,0 +1,121 @@
+#include "AtlasPacker.hpp"
+
+#include <algorithm>
+#include <limits>
+
+//                      ---- Construction ----
+
+sdl3::AtlasPacker::AtlasPacker(int width, int height, int padding)
+    : m_width{width}
+    , m_height{height}
+    , m_padding{padding}
+{
+    AtlasPacker::reset();
+}
+
+//                      ---- Public Functions ----
+
+std::optional<SDL_Rect> sdl3::AtlasPacker::pack(int width, int height)
+{
+    // Padding is reserved to the right and below so neighbors never touch.
+    const int paddedWidth  = width + m_padding;
+    const int paddedHeight = height + m_padding;
+
+    // Bottom-left heuristic: lowest Y wins, ties go to the narrowest segment.
+    size_t bestIndex = m_skyline.size();
+    int bestY        = std::numeric_limits<int>::max();
+    int bestWidth    = std::numeric_limits<int>::max();
+
+    for (size_t i = 0; i < m_skyline.size(); i++)
+    {
+        const std::optional<int> fitY = AtlasPacker::fit_at(i, paddedWidth, paddedHeight);
+        if (!fitY.has_value()) { continue; }
+
+        const int nodeWidth = m_skyline[i].width;
+        if (*fitY < bestY || (*fitY == bestY && nodeWidth < bestWidth))
+        {
+            bestIndex = i;
+            bestY     = *fitY;
+            bestWidth = nodeWidth;
+        }
+    }
+
+    // Nothing fit.
+    if (bestIndex == m_skyline.size()) { return std::nullopt; }
+
+    // Reserve the padded area, but only hand back the part the caller asked for.
+    const SDL_Rect reserved = {.x = m_skyline[bestIndex].x, .y = bestY, .w = paddedWidth, .h = paddedHeight};
+    AtlasPacker::raise_skyline(bestIndex, reserved);
+
+    return SDL_Rect{.x = reserved.x, .y = reserved.y, .w = width, .h = height};
+}
+
+void sdl3::AtlasPacker::reset()
+{
+    m_skyline.clear();
+    m_skyline.push_back({.x = 0, .y = 0, .width = m_width});
+}
+
+int sdl3::AtlasPacker::get_width() const noexcept { return m_width; }
+
+int sdl3::AtlasPacker::get_height() const noexcept { return m_height; }
+
+//                      ---- Private Functions ----
+
+std::optional<int> sdl3::AtlasPacker::fit_at(size_t index, int width, int height) const noexcept
+{
+    // Make sure it doesn't run off the right edge.
+    const int x = m_skyline[index].x;
+    if (x + width > m_width) { return std::nullopt; }
+
+    // The rectangle has to sit on top of the tallest segment it spans.
+    int y              = 0;
+    int widthRemaining = width;
+    for (size_t i = index; widthRemaining > 0; i++)
+    {
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_height) { return std::nullopt; }
+
+        widthRemaining -= m_skyline[i].width;
+    }
+
+    return y;
+}
+
+void sdl3::AtlasPacker::raise_skyline(size_t index, const SDL_Rect &rect)
+{
+    // Insert the new segment on top of the rectangle.
+    const SkylineNode newNode = {.x = rect.x, .y = rect.y + rect.h, .width = rect.w};
+    m_skyline.insert(m_skyline.begin() + index, newNode);
+
+    // Trim or remove the segments that are now covered by the new one.
+    const int newRight = rect.x + rect.w;
+    for (size_t i = index + 1; i < m_skyline.size();)
+    {
+        SkylineNode &node = m_skyline[i];
+        if (node.x >= newRight) { break; }
+
+        const int nodeRight = node.x + node.width;
+        if (nodeRight <= newRight)
+        {
+            m_skyline.erase(m_skyline.begin() + i);
+            continue;
+        }
+
+        node.width = nodeRight - newRight;
+        node.x     = newRight;
+        break;
+    }
+
+    // Merge neighboring segments that ended up at the same height.
+    for (size_t i = 0; i + 1 < m_skyline.size();)
+    {
+        if (m_skyline[i].y == m_skyline[i + 1].y)
+        {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+            continue;
+        }
+        ++i;
+    }
+}
@@ -0,0 +1,105 @@
+#include "CodepointMap.hpp"
+
+//                      ---- Construction ----
+
+//                      ---- Public Functions ----
+
+std::optional<uint32_t> sdl3::CodepointMap::find(char32_t codepoint) const noexcept
+{
+    if (m_slots.empty()) { return std::nullopt; }
+
+    // Linear probe until the codepoint or an empty slot is found.
+    const size_t mask = m_slots.size() - 1;
+    for (size_t i = CodepointMap::home_slot(codepoint);; i = (i + 1) & mask)
+    {
+        const CodepointMap::Slot &slot = m_slots[i];
+        if (slot.codepoint == codepoint) { return slot.value; }
+        else if (slot.codepoint == EMPTY_SLOT) { return std::nullopt; }
+    }
+}
+
+void sdl3::CodepointMap::insert(char32_t codepoint, uint32_t value)
+{
+    // Keep the load factor under 3/4 so probe chains stay short.
+    if ((m_count + 1) * 4 > m_slots.size() * 3) { CodepointMap::grow(); }
+
+    const size_t mask = m_slots.size() - 1;
+    for (size_t i = CodepointMap::home_slot(codepoint);; i = (i + 1) & mask)
+    {
+        CodepointMap::Slot &slot = m_slots[i];
+        if (slot.codepoint == codepoint)
+        {
+            slot.value = value;
+            return;
+        }
+        else if (slot.codepoint == EMPTY_SLOT)
+        {
+            slot = {.codepoint = codepoint, .value = value};
+            ++m_count;
+            return;
+        }
+    }
+}
+
+bool sdl3::CodepointMap::erase(char32_t codepoint) noexcept
+{
+    if (m_slots.empty()) { return false; }
+
+    // Find the slot it's in first.
+    const size_t mask = m_slots.size() - 1;
+    size_t hole       = CodepointMap::home_slot(codepoint);
+    for (;; hole = (hole + 1) & mask)
+    {
+        if (m_slots[hole].codepoint == codepoint) { break; }
+        else if (m_slots[hole].codepoint == EMPTY_SLOT) { return false; }
+    }
+
+    // Shift the rest of the chain back into the hole instead of leaving a tombstone. An entry can only move back if
+    // its home slot isn't between the hole and where it is now.
+    for (size_t i = (hole + 1) & mask; m_slots[i].codepoint != EMPTY_SLOT; i = (i + 1) & mask)
+    {
+        const size_t home = CodepointMap::home_slot(m_slots[i].codepoint);
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            m_slots[hole] = m_slots[i];
+            hole          = i;
+        }
+    }
+
+    m_slots[hole].codepoint = EMPTY_SLOT;
+    --m_count;
+
+    return true;
+}
+
+size_t sdl3::CodepointMap::size() const noexcept { return m_count; }
+
+void sdl3::CodepointMap::clear()
+{
+    m_slots.clear();
+    m_count = 0;
+}
+
+//                      ---- Private Functions ----
+
+size_t sdl3::CodepointMap::home_slot(char32_t codepoint) const noexcept
+{
+    // Fibonacci hashing. Codepoints used together tend to be close to each other, so this spreads them out.
+    return (static_cast<uint32_t>(codepoint) * 0x9E3779B1u) & (m_slots.size() - 1);
+}
+
+void sdl3::CodepointMap::grow()
+{
+    // Swap the old slots out and reinsert everything into the bigger table.
+    std::vector<CodepointMap::Slot> oldSlots{};
+    oldSlots.swap(m_slots);
+
+    const size_t newCapacity = oldSlots.empty() ? INITIAL_CAPACITY : oldSlots.size() * 2;
+    m_slots.assign(newCapacity, {.codepoint = EMPTY_SLOT, .value = 0});
+    m_count = 0;
+
+    for (const CodepointMap::Slot &slot : oldSlots)
+    {
+        if (slot.codepoint != EMPTY_SLOT) { CodepointMap::insert(slot.codepoint, slot.value); }
+    }
+}
@@ -0,0 +1,160 @@
+#include "DrawList.hpp"
+
+#include <array>
+
+//                      ---- Construction ----
+
+//                      ---- Public Functions ----
+
+uint64_t sdl3::DrawList::make_key(uint8_t layer, uint16_t depth, uint32_t textureId, uint8_t blend) noexcept
+{
+    // Layer | depth | texture | blend | unused.
+    return static_cast<uint64_t>(layer) << 56 | static_cast<uint64_t>(depth) << 40 |
+           static_cast<uint64_t>(textureId & 0xFFFFFF) << 16 | static_cast<uint64_t>(blend) << 8;
+}
+
+void sdl3::DrawList::add_texture(uint64_t key, sdl3::Texture &texture, int x, int y)
+{
+    const int width  = texture.get_width();
+    const int height = texture.get_height();
+
+    DrawList::push_command(key,
+                           {.type       = DrawList::Command::Type::Texture,
+                            .texture    = &texture,
+                            .sourceRect = {.x = 0, .y = 0, .w = width, .h = height},
+                            .destRect   = {.x = x, .y = y, .w = width, .h = height}});
+}
+
+void sdl3::DrawList::add_texture_part(uint64_t key,
+                                      sdl3::Texture &texture,
+                                      const SDL_Rect &sourceRect,
+                                      const SDL_Rect &destRect)
+{
+    DrawList::push_command(key,
+                           {.type       = DrawList::Command::Type::Texture,
+                            .texture    = &texture,
+                            .sourceRect = sourceRect,
+                            .destRect   = destRect});
+}
+
+void sdl3::DrawList::add_rect(uint64_t key, const SDL_FRect &rect, SDL_Color color)
+{
+    DrawList::push_command(key, {.type = DrawList::Command::Type::Rect, .rect = rect, .color = color});
+}
+
+void sdl3::DrawList::add_callback(uint64_t key, DrawList::Callback callback)
+{
+    DrawList::push_command(key, {.type = DrawList::Command::Type::Callback, .callback = m_callbacks.size()});
+    m_callbacks.push_back(std::move(callback));
+}
+
+bool sdl3::DrawList::execute(sdl3::Renderer &renderer)
+{
+    DrawList::sort();
+
+    // Textures go through the sprite batch, which merges neighbors using the same texture into one draw.
+    const bool batching = renderer.get_sprite_batch().is_active();
+    if (!batching) { renderer.begin_batch(); }
+
+    bool success = true;
+    for (const DrawList::SortEntry &entry : m_entries)
+    {
+        const DrawList::Command &command = m_commands[entry.command];
+        if (command.type == DrawList::Command::Type::Rect)
+        {
+            m_rects.push_back(command.rect);
+            m_rectColors.push_back(command.color);
+            continue;
+        }
+
+        // Anything else ends a run of rects.
+        success = DrawList::flush_rects(renderer) && success;
+
+        if (command.type == DrawList::Command::Type::Texture)
+        {
+            const SDL_Rect &source = command.sourceRect;
+            const SDL_Rect &dest   = command.destRect;
+            const bool rendered    = command.texture->render_part_stretched(dest.x,
+                                                                          dest.y,
+                                                                          dest.w,
+                                                                          dest.h,
+                                                                          source.x,
+                                                                          source.y,
+                                                                          source.w,
+                                                                          source.h);
+            success                = rendered && success;
+            continue;
+        }
+
+        // Callbacks might render straight through SDL, so everything before them has to be submitted first.
+        success = renderer.flush_batch() && success;
+        m_callbacks[command.callback](renderer);
+    }
+
+    success = DrawList::flush_rects(renderer) && success;
+    if (!batching) { success = renderer.end_batch() && success; }
+
+    return success;
+}
+
+void sdl3::DrawList::clear()
+{
+    m_commands.clear();
+    m_callbacks.clear();
+    m_entries.clear();
+    m_sorted = true;
+}
+
+size_t sdl3::DrawList::size() const noexcept { return m_commands.size(); }
+
+//                      ---- Private Functions ----
+
+bool sdl3::DrawList::flush_rects(sdl3::Renderer &renderer)
+{
+    if (m_rects.empty()) { return true; }
+
+    const bool success = renderer.fill_rects(m_rects, m_rectColors);
+    m_rects.clear();
+    m_rectColors.clear();
+
+    return success;
+}
+
+void sdl3::DrawList::push_command(uint64_t key, const DrawList::Command &command)
+{
+    // Keys submitted in order don't need sorting at all.
+    if (!m_entries.empty() && key < m_entries.back().key) { m_sorted = false; }
+
+    m_entries.push_back({.key = key, .command = static_cast<uint32_t>(m_commands.size())});
+    m_commands.push_back(command);
+}
+
+void sdl3::DrawList::sort()
+{
+    if (m_sorted) { return; }
+
+    m_sortBuffer.resize(m_entries.size());
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        std::array<size_t, 256> offsets{};
+        for (const DrawList::SortEntry &entry : m_entries) { ++offsets[(entry.key >> shift) & 0xFF]; }
+
+        // Every key has the same byte here, so this pass wouldn't move anything.
+        if (offsets[(m_entries.front().key >> shift) & 0xFF] == m_entries.size()) { continue; }
+
+        // Counts to starting offsets.
+        size_t offset{};
+        for (size_t &bucket : offsets)
+        {
+            const size_t count = bucket;
+            bucket             = offset;
+            offset += count;
+        }
+
+        // Scattering in order keeps the sort stable, so equal keys stay in submission order.
+        for (const DrawList::SortEntry &entry : m_entries) { m_sortBuffer[offsets[(entry.key >> shift) & 0xFF]++] = entry; }
+        m_entries.swap(m_sortBuffer);
+    }
+
+    m_sorted = true;
+}
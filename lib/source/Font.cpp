@@ -1,242 +1,1144 @@
 #include "Font.hpp"
 
 #include "Freetype.hpp"
+#include "PixelOps.hpp"
 #include "ResourceManager.hpp"
-#include "Surface.hpp"
+#include "ThreadPool.hpp"
+#include "UTF8.hpp"
 
-#include <filesystem>
-#include <format>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <limits>
 #include <span>
 
-//                      ---- Construction ----
-
-sdl3::Font::Font(std::string_view fontPath, int pixelSize)
-    : m_pixelSize{pixelSize}
+namespace
 {
-    // Attempt to get the file size of the font.
-    const size_t fontSize = std::filesystem::file_size(fontPath);
-    if (fontSize == 0) { return; }
+    /// @brief Identifies font cache files.
+    constexpr uint32_t CACHE_MAGIC = 0x46434653;
+
+    /// @brief Bumped whenever the layout of the cache file changes.
+    constexpr uint32_t CACHE_VERSION = 1;
+
+    /// @brief Largest page dimension accepted from a cache file.
+    constexpr int32_t CACHE_MAX_PAGE_SIZE = 16384;
 
-    // Buffer for the font.
-    m_fontBuffer = std::make_unique<char[]>(fontSize);
-    if (!m_fontBuffer) { return; }
+    // clang-format off
+    /// @brief Start of the cache file.
+    struct CacheHeader
+    {
+        uint32_t magic{};
+        uint32_t version{};
+        uint64_t fontKey{};
+        int32_t pixelSize{};
+        uint32_t pageCount{};
+        uint32_t glyphCount{};
+        uint32_t reserved{};
+    };
 
-    // Open the font for reading.
-    std::ifstream fontFile{fontPath.data(), std::ios::binary};
-    if (!fontFile.is_open()) { return; }
+    /// @brief Every page is stored as this followed by width * height bytes of coverage.
+    struct CachePage
+    {
+        int32_t width{};
+        int32_t height{};
+    };
 
-    // Read it to buffer.
-    fontFile.read(m_fontBuffer.get(), fontSize);
-    if (fontFile.gcount() != fontSize) { return; }
+    /// @brief Glyph records follow the pages.
+    struct CacheGlyph
+    {
+        uint32_t codepoint{};
+        int16_t advanceX{};
+        int16_t top{};
+        int16_t left{};
+        uint16_t page{};
+        int16_t x{};
+        int16_t y{};
+        int16_t width{};
+        int16_t height{};
+    };
+    // clang-format on
 
-    // Create the font face.
-    FT_Error ftError = FT_New_Memory_Face(sm_freetype.get_library(),
-                                          reinterpret_cast<FT_Byte *>(m_fontBuffer.get()),
-                                          fontSize,
-                                          0,
-                                          &m_fontFace);
-    if (ftError != 0) { return; }
+    /// @brief Palette for alpha only pages. Every index is white with the index as alpha.
+    const std::array<SDL_Color, 256> &get_coverage_palette()
+    {
+        static const std::array<SDL_Color, 256> palette = []() {
+            std::array<SDL_Color, 256> colors{};
+            for (size_t i = 0; i < colors.size(); i++) { colors[i] = {0xFF, 0xFF, 0xFF, static_cast<uint8_t>(i)}; }
+            return colors;
+        }();
+
+        return palette;
+    }
+
+    /// @brief Converts the SDL_Color passed to the float color vertices use.
+    SDL_FColor to_vertex_color(SDL_Color color)
+    {
+        return {.r = color.r / 255.0f, .g = color.g / 255.0f, .b = color.b / 255.0f, .a = color.a / 255.0f};
+    }
+}
+
+//                      ---- Construction ----
+
+sdl3::Font::Font(std::string_view fontPath, int pixelSize)
+    : m_pixelSize{pixelSize}
+{
+    // Every size loaded from the same file shares one mapping.
+    sdl3::SharedMappedFile fontFile = sdl3::MappedFileManager::load_resource(fontPath, fontPath);
+    if (!fontFile->is_initialized()) { return; }
 
-    // Set the size.
-    ftError = FT_Set_Pixel_Sizes(m_fontFace, 0, m_pixelSize);
-    if (ftError != 0) { return; }
+    // Create the font face at the right size.
+    FT_Face fontFace = Font::open_face(sm_freetype.get_library(), *fontFile, m_pixelSize);
+    if (!fontFace) { return; }
 
+    m_faces.push_back({.file = std::move(fontFile), .face = fontFace});
+    sm_fonts.push_back(this);
     m_isValid = true;
 }
 
 sdl3::Font::~Font()
 {
-    if (!m_fontFace) { return; }
+    // Give the memory back to the shared budget.
+    std::erase(sm_fonts, this);
+    sm_sharedGlyphUsage -= m_glyphMemoryUsage;
 
-    FT_Done_Face(m_fontFace);
+    // Jobs still running hold their own reference to the mappings and state, so there's no need to wait for them.
+    for (const Font::FontFace &fontFace : m_faces) { FT_Done_Face(fontFace.face); }
 }
 
 //                      ---- Public Functions ----
 
+bool sdl3::Font::add_fallback_font(std::string_view fontPath)
+{
+    if (!m_isValid) { return false; }
+
+    sdl3::SharedMappedFile fontFile = sdl3::MappedFileManager::load_resource(fontPath, fontPath);
+    if (!fontFile->is_initialized()) { return false; }
+
+    FT_Face fontFace = Font::open_face(sm_freetype.get_library(), *fontFile, m_pixelSize);
+    if (!fontFace) { return false; }
+
+    m_faces.push_back({.file = std::move(fontFile), .face = fontFace});
+
+    // Anything resolved so far might come from the new face now. That includes glyphs without a bitmap, since a
+    // codepoint missing from every face so far was stored as an empty .notdef glyph.
+    m_faceMap.clear();
+    for (size_t i = 0; i < m_pages.size(); i++)
+    {
+        if (m_pages[i].texture) { Font::evict_page(i); }
+    }
+
+    // Only glyphs without a bitmap are left after the pages are gone.
+    m_glyphs.clear();
+    m_freeGlyphSlots.clear();
+    m_flatGlyphs.fill(0);
+    m_glyphMap.clear();
+    ++m_evictionGeneration;
+
+    return true;
+}
+
 void sdl3::Font::render_text(int x, int y, SDL_Color renderColor, std::string_view text)
 {
-    // Store this because we might need it.
-    const int originalX = x;
+    const Font::TextLayout &layout = Font::get_layout(text, NO_WRAP);
+    Font::render_layout(x, y, renderColor, layout);
+}
+
+void sdl3::Font::render_text_wrapped(int x, int y, int maxWidth, SDL_Color renderColor, std::string_view text)
+{
+    const Font::TextLayout &layout = Font::get_layout(text, maxWidth);
+    Font::render_layout(x, y, renderColor, layout);
+}
+
+bool sdl3::Font::render_text_to_surface(sdl3::Surface &surface, int x, int y, SDL_Color renderColor, std::string_view text)
+{
+    if (!surface || SDL_BYTESPERPIXEL(surface->format) != 4) { return false; }
+
+    const Font::TextLayout &layout = Font::get_layout(text, NO_WRAP);
+
+    // The color is mapped once. Every channel is blended the same way after that, so the channel order doesn't matter.
+    const uint32_t color = SDL_MapSurfaceRGBA(surface.get(), renderColor.r, renderColor.g, renderColor.b, 0xFF);
+
+    const bool mustLock = SDL_MUSTLOCK(surface.get());
+    if (mustLock && !SDL_LockSurface(surface.get())) { return false; }
+
+    uint32_t *pixels     = static_cast<uint32_t *>(surface->pixels);
+    const int pixelPitch = surface->pitch / static_cast<int>(sizeof(uint32_t));
+    for (const Font::PositionedGlyph &glyph : layout.glyphs)
+    {
+        // Clip the glyph to the surface.
+        const int left   = std::max(x + glyph.x, 0);
+        const int top    = std::max(y + glyph.y, 0);
+        const int right  = std::min(x + glyph.x + glyph.source.w, surface->w);
+        const int bottom = std::min(y + glyph.y + glyph.source.h, surface->h);
+        if (left >= right || top >= bottom) { continue; }
+
+        // Blend straight from the page's CPU side copy.
+        Font::AtlasPage &page = m_pages[glyph.page];
+        page.lastUse          = sm_useClock;
+
+        const int pageWidth     = page.packer.get_width();
+        const int sourceX       = glyph.source.x + (left - (x + glyph.x));
+        const int sourceY       = glyph.source.y + (top - (y + glyph.y));
+        const uint8_t *coverage = page.coverage.data() + (sourceY * pageWidth) + sourceX;
+        sdl3::pixel_ops::blend_coverage(coverage,
+                                        pageWidth,
+                                        pixels + (top * pixelPitch) + left,
+                                        pixelPitch,
+                                        right - left,
+                                        bottom - top,
+                                        color,
+                                        renderColor.a);
+    }
+
+    if (mustLock) { SDL_UnlockSurface(surface.get()); }
+
+    return true;
+}
+
+size_t sdl3::Font::get_text_width(std::string_view text) { return Font::get_layout(text, NO_WRAP).width; }
+
+sdl3::Font::TextMetrics sdl3::Font::measure_text(std::string_view text) { return Font::measure_text_wrapped(text, NO_WRAP); }
+
+sdl3::Font::TextMetrics sdl3::Font::measure_text_wrapped(std::string_view text, int maxWidth)
+{
+    const Font::TextLayout &layout = Font::get_layout(text, maxWidth);
+    return {.width = layout.width, .height = layout.height, .lineCount = layout.lines.size()};
+}
+
+std::span<const sdl3::Font::LineRecord> sdl3::Font::get_text_lines(std::string_view text, int maxWidth)
+{
+    return Font::get_layout(text, maxWidth).lines;
+}
+
+void sdl3::Font::preload(std::string_view charset)
+{
+    if (!m_isValid) { return; }
+
+    // Gather every codepoint that isn't cached already.
+    std::vector<char32_t> codepoints{};
+    for (size_t i = 0; i < charset.length();)
+    {
+        const char32_t codepoint = sdl3::utf8::decode_next(charset, i);
+        if (codepoint == '\n' || Font::find_glyph_index(codepoint).has_value()) { continue; }
+
+        codepoints.push_back(codepoint);
+    }
+
+    std::sort(codepoints.begin(), codepoints.end());
+    codepoints.erase(std::unique(codepoints.begin(), codepoints.end()), codepoints.end());
+
+    // Faces are resolved here since the memo belongs to this thread. Known failures are skipped.
+    std::vector<Font::GlyphRequest> requests{};
+    for (const char32_t codepoint : codepoints)
+    {
+        const uint32_t face = Font::resolve_face(codepoint);
+        if (face != MISSING_GLYPH) { requests.push_back({.codepoint = codepoint, .face = face}); }
+    }
+    if (requests.empty()) { return; }
+
+    // Workers only need the files. They open faces of their own.
+    std::vector<sdl3::SharedMappedFile> fontFiles{};
+    for (const Font::FontFace &fontFace : m_faces) { fontFiles.push_back(fontFace.file); }
+
+    // Split the work evenly between the workers, but don't bother splitting tiny sets up.
+    sdl3::ThreadPool &pool  = sdl3::ThreadPool::get_shared();
+    const size_t maxJobs    = (requests.size() + PRELOAD_CHUNK_SIZE - 1) / PRELOAD_CHUNK_SIZE;
+    const size_t jobCount   = std::min(pool.get_worker_count(), maxJobs);
+    const size_t chunkSize  = (requests.size() + jobCount - 1) / jobCount;
+
+    for (size_t i = 0; i < requests.size(); i += chunkSize)
+    {
+        const size_t chunkEnd = std::min(requests.size(), i + chunkSize);
+        std::vector<Font::GlyphRequest> chunk{requests.begin() + i, requests.begin() + chunkEnd};
+
+        {
+            std::lock_guard preloadLock{m_preload->mutex};
+            ++m_preload->pendingJobs;
+        }
+
+        pool.submit([state = m_preload, fontFiles, pixelSize = m_pixelSize, chunk = std::move(chunk)]()
+                    { Font::rasterize_glyphs(state, fontFiles, pixelSize, std::move(chunk)); });
+    }
+}
+
+bool sdl3::Font::upload_preloaded(uint64_t budgetMs)
+{
+    const uint64_t deadline = SDL_GetTicksNS() + SDL_MS_TO_NS(budgetMs);
+
+    // Take whatever the workers have finished so far.
+    {
+        std::lock_guard preloadLock{m_preload->mutex};
+        std::move(m_preload->ready.begin(), m_preload->ready.end(), std::back_inserter(m_uploadQueue));
+        m_preload->ready.clear();
+    }
+
+    // Upload until we run out of glyphs or time. At least one glyph is always uploaded so warmup can't stall.
+    while (m_uploadIndex < m_uploadQueue.size())
+    {
+        const Font::RasterGlyph &rasterGlyph = m_uploadQueue[m_uploadIndex++];
+
+        // Each glyph is its own use so pages filled by earlier ones can be evicted if the budget is tight.
+        ++sm_useClock;
+
+        // It may have been needed and loaded on this thread in the meantime.
+        if (!Font::find_glyph_index(rasterGlyph.codepoint).has_value())
+        {
+            const Font::GlyphBitmap glyphBitmap = {.buffer = rasterGlyph.coverage.data(),
+                                                   .width  = rasterGlyph.width,
+                                                   .height = rasterGlyph.height,
+                                                   .pitch  = rasterGlyph.width};
+            Font::insert_glyph(rasterGlyph.codepoint, rasterGlyph.glyphData, glyphBitmap);
+        }
+
+        if (SDL_GetTicksNS() >= deadline) { break; }
+    }
+
+    if (m_uploadIndex == m_uploadQueue.size())
+    {
+        m_uploadQueue.clear();
+        m_uploadIndex = 0;
+    }
+
+    return Font::preload_complete();
+}
+
+bool sdl3::Font::preload_complete() const
+{
+    std::lock_guard preloadLock{m_preload->mutex};
+    return m_preload->pendingJobs == 0 && m_preload->ready.empty() && m_uploadQueue.empty();
+}
+
+void sdl3::Font::set_layout_cache_capacity(size_t capacity)
+{
+    m_layoutCapacity = capacity;
+
+    // Drop the oldest layouts until we fit.
+    while (m_layoutList.size() > m_layoutCapacity)
+    {
+        m_layoutMap.erase({m_layoutList.back().text, m_layoutList.back().wrapWidth});
+        m_layoutList.pop_back();
+    }
+}
+
+void sdl3::Font::clear_layout_cache()
+{
+    m_layoutMap.clear();
+    m_layoutList.clear();
+}
+
+sdl3::Font::LayoutCacheStats sdl3::Font::get_layout_cache_stats() const noexcept
+{
+    return {.hits = m_layoutHits, .misses = m_layoutMisses, .size = m_layoutList.size(), .capacity = m_layoutCapacity};
+}
+
+void sdl3::Font::reset_layout_cache_stats() noexcept
+{
+    m_layoutHits   = 0;
+    m_layoutMisses = 0;
+}
+
+bool sdl3::Font::save_cache(std::string_view cachePath) const
+{
+    if (!m_isValid) { return false; }
+
+    // Evicted pages are skipped, so page indices are remapped to be contiguous.
+    std::vector<uint16_t> pageMap(m_pages.size());
+    uint32_t pageCount{};
+    for (size_t i = 0; i < m_pages.size(); i++)
+    {
+        if (m_pages[i].texture) { pageMap[i] = static_cast<uint16_t>(pageCount++); }
+    }
+
+    // Gather the glyphs.
+    std::vector<CacheGlyph> cacheGlyphs{};
+    auto add_glyph = [&](char32_t codepoint, uint32_t glyphIndex)
+    {
+        const Font::GlyphData &glyphData = m_glyphs[glyphIndex];
+        const bool hasBitmap             = glyphData.source.w > 0 && glyphData.source.h > 0;
+        cacheGlyphs.push_back({.codepoint = static_cast<uint32_t>(codepoint),
+                               .advanceX  = glyphData.advanceX,
+                               .top       = glyphData.top,
+                               .left      = glyphData.left,
+                               .page      = hasBitmap ? pageMap[glyphData.page] : uint16_t{0},
+                               .x         = static_cast<int16_t>(glyphData.source.x),
+                               .y         = static_cast<int16_t>(glyphData.source.y),
+                               .width     = static_cast<int16_t>(glyphData.source.w),
+                               .height    = static_cast<int16_t>(glyphData.source.h)});
+    };
+
+    for (size_t i = 0; i < FLAT_GLYPH_COUNT; i++)
+    {
+        if (m_flatGlyphs[i] != 0) { add_glyph(static_cast<char32_t>(i), m_flatGlyphs[i] - 1); }
+    }
+    m_glyphMap.for_each(add_glyph);
+
+    std::ofstream cacheFile{std::string{cachePath}, std::ios::binary};
+    if (!cacheFile.is_open()) { return false; }
+
+    const CacheHeader header = {.magic      = CACHE_MAGIC,
+                                .version    = CACHE_VERSION,
+                                .fontKey    = Font::get_cache_key(),
+                                .pixelSize  = m_pixelSize,
+                                .pageCount  = pageCount,
+                                .glyphCount = static_cast<uint32_t>(cacheGlyphs.size())};
+    cacheFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    // Pages are written straight from the CPU side copy.
+    for (const Font::AtlasPage &page : m_pages)
+    {
+        if (!page.texture) { continue; }
+
+        const CachePage cachePage = {.width = page.packer.get_width(), .height = page.packer.get_height()};
+        cacheFile.write(reinterpret_cast<const char *>(&cachePage), sizeof(cachePage));
+        cacheFile.write(reinterpret_cast<const char *>(page.coverage.data()), page.coverage.size());
+    }
+
+    cacheFile.write(reinterpret_cast<const char *>(cacheGlyphs.data()), cacheGlyphs.size() * sizeof(CacheGlyph));
+
+    return cacheFile.good();
+}
+
+bool sdl3::Font::load_cache(std::string_view cachePath)
+{
+    if (!m_isValid) { return false; }
+
+    // The whole file is mapped and read from directly.
+    const sdl3::MappedFile cacheFile{cachePath};
+    if (!cacheFile.is_initialized()) { return false; }
+
+    const std::span<const uint8_t> cacheData = cacheFile.get_data();
+    size_t offset{};
+    auto read = [&](void *dest, size_t size)
+    {
+        if (offset + size > cacheData.size()) { return false; }
+
+        std::memcpy(dest, cacheData.data() + offset, size);
+        offset += size;
+        return true;
+    };
+
+    // Make sure it was written for this font.
+    CacheHeader header{};
+    if (!read(&header, sizeof(header))) { return false; }
+
+    const bool identified = header.magic == CACHE_MAGIC && header.version == CACHE_VERSION;
+    const bool matches    = header.fontKey == Font::get_cache_key() && header.pixelSize == m_pixelSize;
+    if (!identified || !matches) { return false; }
+
+    // Walk the pages once to validate them before anything is created.
+    std::vector<CachePage> cachePages(header.pageCount);
+    std::vector<size_t> coverageOffsets(header.pageCount);
+    for (uint32_t i = 0; i < header.pageCount; i++)
+    {
+        CachePage &cachePage = cachePages[i];
+        if (!read(&cachePage, sizeof(cachePage))) { return false; }
+
+        const bool validWidth  = cachePage.width > 0 && cachePage.width <= CACHE_MAX_PAGE_SIZE;
+        const bool validHeight = cachePage.height > 0 && cachePage.height <= CACHE_MAX_PAGE_SIZE;
+        if (!validWidth || !validHeight) { return false; }
+
+        const size_t coverageSize = static_cast<size_t>(cachePage.width) * cachePage.height;
+        if (offset + coverageSize > cacheData.size()) { return false; }
+
+        coverageOffsets[i] = offset;
+        offset += coverageSize;
+    }
+
+    std::vector<CacheGlyph> cacheGlyphs(header.glyphCount);
+    if (!read(cacheGlyphs.data(), cacheGlyphs.size() * sizeof(CacheGlyph))) { return false; }
+
+    // Create and upload the pages. Everything created here is stamped with the same use so none of them can be evicted
+    // to make room for the others.
+    const size_t previousPage = m_currentPage;
+    std::vector<uint16_t> pageMap(header.pageCount);
+    for (uint32_t i = 0; i < header.pageCount; i++)
+    {
+        const CachePage &cachePage = cachePages[i];
+        const size_t pageIndex     = Font::create_atlas_page(cachePage.width, cachePage.height);
+        Font::AtlasPage &page      = m_pages[pageIndex];
+        pageMap[i]                 = static_cast<uint16_t>(pageIndex);
+
+        const uint8_t *coverage = cacheData.data() + coverageOffsets[i];
+        std::copy(coverage, coverage + page.coverage.size(), page.coverage.begin());
+
+        const SDL_Rect pageRect = {.x = 0, .y = 0, .w = cachePage.width, .h = cachePage.height};
+        if (Font::upload_coverage(page, pageRect, page.coverage.data(), cachePage.width)) { continue; }
+
+        // No glyphs point at the pages yet, so give them all back instead of leaving them charged to the budget.
+        for (uint32_t created = 0; created <= i; created++) { Font::evict_page(pageMap[created]); }
+        m_currentPage = previousPage;
+
+        return false;
+    }
+
+    // The packer doesn't know what's on the loaded pages, so new glyphs go on a new page.
+    m_currentPage = m_pages.size();
+
+    for (const CacheGlyph &cacheGlyph : cacheGlyphs)
+    {
+        const char32_t codepoint = static_cast<char32_t>(cacheGlyph.codepoint);
+        if (Font::find_glyph_index(codepoint).has_value()) { continue; }
+
+        // Glyphs with a bitmap have to land inside the page they claim to be on.
+        const bool hasBitmap = cacheGlyph.width > 0 && cacheGlyph.height > 0;
+        if (hasBitmap)
+        {
+            if (cacheGlyph.page >= header.pageCount || cacheGlyph.x < 0 || cacheGlyph.y < 0) { continue; }
+
+            const CachePage &cachePage = cachePages[cacheGlyph.page];
+            const bool insideX         = cacheGlyph.x + cacheGlyph.width <= cachePage.width;
+            const bool insideY         = cacheGlyph.y + cacheGlyph.height <= cachePage.height;
+            if (!insideX || !insideY) { continue; }
+        }
+
+        const Font::GlyphData glyphData = {.advanceX = cacheGlyph.advanceX,
+                                           .top      = cacheGlyph.top,
+                                           .left     = cacheGlyph.left,
+                                           .page     = hasBitmap ? pageMap[cacheGlyph.page] : uint16_t{0},
+                                           .source   = {.x = cacheGlyph.x,
+                                                        .y = cacheGlyph.y,
+                                                        .w = hasBitmap ? cacheGlyph.width : 0,
+                                                        .h = hasBitmap ? cacheGlyph.height : 0}};
+        Font::store_glyph(codepoint, glyphData);
+    }
+
+    return true;
+}
+
+void sdl3::Font::set_glyph_memory_budget(size_t budgetBytes)
+{
+    m_glyphMemoryBudget = budgetBytes;
+
+    // Nothing is being laid out right now, so every page is fair game.
+    ++sm_useClock;
+    Font::make_room(0);
+}
+
+size_t sdl3::Font::get_glyph_memory_usage() const noexcept { return m_glyphMemoryUsage; }
+
+void sdl3::Font::set_shared_glyph_memory_budget(size_t budgetBytes)
+{
+    sm_sharedGlyphBudget = budgetBytes;
+    if (sm_fonts.empty()) { return; }
+
+    ++sm_useClock;
+    sm_fonts.front()->make_room(0);
+}
+
+size_t sdl3::Font::get_shared_glyph_memory_usage() noexcept { return sm_sharedGlyphUsage; }
+
+//                      ---- Private Functions ----
+
+const sdl3::Font::TextLayout &sdl3::Font::get_layout(std::string_view text, int wrapWidth)
+{
+    // Cache hit. Move it to the front so it's the last to be evicted.
+    const auto findLayout = m_layoutMap.find({text, wrapWidth});
+    if (findLayout != m_layoutMap.end())
+    {
+        m_layoutList.splice(m_layoutList.begin(), m_layoutList, findLayout->second);
+
+        // Layouts built before a page was evicted might point at glyphs that aren't there anymore.
+        Font::LayoutEntry &entry = *findLayout->second;
+        if (entry.generation == m_evictionGeneration) { ++m_layoutHits; }
+        else
+        {
+            ++m_layoutMisses;
+            Font::build_layout(entry.text, wrapWidth, entry.layout);
+            entry.generation = m_evictionGeneration;
+        }
+
+        return entry.layout;
+    }
+
+    ++m_layoutMisses;
+
+    // With caching turned off, everything is laid out in scratch space.
+    if (m_layoutCapacity == 0)
+    {
+        Font::build_layout(text, wrapWidth, m_scratchLayout);
+        return m_scratchLayout;
+    }
+
+    // Recycle the oldest entry when full so its buffers are reused instead of freed and allocated again.
+    if (m_layoutList.size() >= m_layoutCapacity)
+    {
+        m_layoutMap.erase({m_layoutList.back().text, m_layoutList.back().wrapWidth});
+        m_layoutList.splice(m_layoutList.begin(), m_layoutList, std::prev(m_layoutList.end()));
+    }
+    else
+    {
+        m_layoutList.emplace_front();
+    }
+
+    // Fill it in. The map's key views the string stored in the entry, so it has to be assigned first.
+    Font::LayoutEntry &entry = m_layoutList.front();
+    entry.text.assign(text);
+    entry.wrapWidth = wrapWidth;
+    Font::build_layout(entry.text, wrapWidth, entry.layout);
+    entry.generation = m_evictionGeneration;
+    m_layoutMap.try_emplace({entry.text, entry.wrapWidth}, m_layoutList.begin());
+
+    return entry.layout;
+}
+
+void sdl3::Font::build_layout(std::string_view text, int wrapWidth, Font::TextLayout &layout)
+{
+    // Distance between the tops of lines.
+    const int lineHeight = m_pixelSize + (m_pixelSize / 4);
+
+    // Pages used from here on are stamped with the new time and can't be evicted until the next layout.
+    ++sm_useClock;
+
+    layout.glyphs.clear();
+    layout.lines.clear();
+    layout.width = 0;
+
+    // Current line and pen position.
+    size_t lineBegin = 0;
+    int lineTop      = 0;
+    int x            = 0;
+
+    // Last place the current line can be broken at.
+    bool hasBreak     = false;
+    size_t breakByte  = 0;
+    size_t breakGlyph = 0;
+    int breakX        = 0;
+    int breakWidth    = 0;
 
-    // Loop through the text and render it.
-    for (const char charCode : text)
+    // Records the current line and moves down to the next one.
+    auto end_line = [&](size_t endByte, int lineWidth)
     {
+        layout.lines.push_back({.begin = lineBegin, .end = endByte, .width = lineWidth, .baseline = lineTop + m_pixelSize});
+        layout.width = std::max(layout.width, lineWidth);
+        lineTop += lineHeight;
+        hasBreak = false;
+    };
+
+    // Every glyph is looked up exactly once. Glyphs that end up on the next line are shifted down after the fact.
+    for (size_t i = 0; i < text.length();)
+    {
+        const size_t charBegin   = i;
+        const char32_t codepoint = sdl3::utf8::decode_next(text, i);
+
         // Handle newlines here instead of processing them after the glyph is loaded.
-        if (charCode == '\n')
+        if (codepoint == '\n')
         {
-            x = originalX;
-            y += m_pixelSize + (m_pixelSize / 4);
+            end_line(charBegin, x);
+            lineBegin = i;
+            x         = 0;
             continue;
         }
 
         // Try to load the glyph first.
-        const auto getGlyph = Font::find_load_glyph(charCode);
+        const auto getGlyph = Font::find_load_glyph(codepoint);
         if (!getGlyph.has_value()) { continue; } // If the optional is empty, just continue the loop.
 
         // Data reference to make things easier to type and read.
         const Font::GlyphData &glyphData = getGlyph->get();
 
-        // Set the color mod.
-        glyphData.texture->set_color_mod(renderColor);
+        // Wrap if this glyph would run past the max width.
+        const bool overflow = wrapWidth != NO_WRAP && x > 0 && x + glyphData.advanceX > wrapWidth;
+        if (overflow && hasBreak)
+        {
+            // Break at the last space or period and carry what came after it down to the new line.
+            end_line(breakByte, breakWidth);
+            for (size_t j = breakGlyph; j < layout.glyphs.size(); j++)
+            {
+                layout.glyphs[j].x -= breakX;
+                layout.glyphs[j].y += lineHeight;
+            }
 
-        // Render the glyph.
-        const int renderX = x + glyphData.left;
-        const int renderY = y + (m_pixelSize - glyphData.top);
-        glyphData.texture->render(renderX, renderY);
+            lineBegin = breakByte;
+            x -= breakX;
+        }
+        else if (overflow)
+        {
+            // Nowhere to break the word, so it's broken right here.
+            end_line(charBegin, x);
+            lineBegin = charBegin;
+            x         = 0;
+        }
+
+        // Record where it goes. Empty glyphs only advance the pen.
+        if (glyphData.source.w > 0 && glyphData.source.h > 0)
+        {
+            layout.glyphs.push_back({.x      = static_cast<int16_t>(x + glyphData.left),
+                                     .y      = static_cast<int16_t>(lineTop + (m_pixelSize - glyphData.top)),
+                                     .page   = glyphData.page,
+                                     .source = glyphData.source});
+        }
 
         // Advance our rendering position.
         x += glyphData.advanceX;
+
+        // Spaces and periods are where lines can be broken. Trailing spaces don't count towards the line's width.
+        if (codepoint == ' ' || codepoint == '.')
+        {
+            hasBreak   = true;
+            breakByte  = i;
+            breakGlyph = layout.glyphs.size();
+            breakX     = x;
+            breakWidth = codepoint == ' ' ? x - glyphData.advanceX : x;
+        }
     }
+
+    // Last line.
+    end_line(text.length(), x);
+    layout.height = lineTop;
 }
 
-void sdl3::Font::render_text_wrapped(int x, int y, int maxWidth, SDL_Color renderColor, std::string_view text)
+void sdl3::Font::render_layout(int x, int y, SDL_Color renderColor, const Font::TextLayout &layout)
 {
-    // Save this just in case.
-    const int originalX = x;
+    // Color every vertex is submitted with.
+    const SDL_FColor vertexColor = to_vertex_color(renderColor);
+
+    for (const Font::PositionedGlyph &glyph : layout.glyphs)
+    {
+        Font::queue_glyph(x + glyph.x, y + glyph.y, glyph.page, glyph.source, vertexColor);
+    }
+
+    // Render everything at once.
+    Font::flush_glyphs();
+}
 
-    // This is our adjusted maxWidth.
-    const int adjustedMax = x + maxWidth;
+sdl3::OptionalReference<sdl3::Font::GlyphData> sdl3::Font::find_load_glyph(char32_t codepoint)
+{
+    // Start by searching the cache for the codepoint.
+    const std::optional<uint32_t> findGlyph = Font::find_glyph_index(codepoint);
+    if (findGlyph.has_value())
+    {
+        Font::GlyphData &glyphData = m_glyphs[*findGlyph];
+        if (glyphData.source.w > 0) { m_pages[glyphData.page].lastUse = sm_useClock; }
 
-    // This is our current width.
-    size_t currentWidth{};
+        return glyphData;
+    }
 
-    // This is different than the above because we need to track the length differently.
-    const size_t textLength = text.length();
+    // Codepoints that failed before aren't retried.
+    const uint32_t faceIndex = Font::resolve_face(codepoint);
+    if (faceIndex == MISSING_GLYPH) { return std::nullopt; }
 
-    // This is so I don't have to repeat this.
-    auto break_line = [&]()
+    // Load it from whichever face has it.
+    const FT_Face fontFace   = m_faces[faceIndex].face;
+    const FT_UInt charIndex  = FT_Get_Char_Index(fontFace, codepoint);
+    const FT_Error loadError = FT_Load_Glyph(fontFace, charIndex, FT_LOAD_RENDER);
+    if (loadError != 0)
     {
-        x = originalX;
-        y += m_pixelSize + (m_pixelSize / 4);
-    };
+        m_faceMap.insert(codepoint, MISSING_GLYPH);
+        return std::nullopt;
+    }
 
-    // Loop through text.
-    for (size_t i = 0; i < textLength;)
+    // This makes things easier to read.
+    const FT_GlyphSlot glyphSlot = fontFace->glyph;
+    const FT_Bitmap &bitmap      = glyphSlot->bitmap;
+
+    // Metrics.
+    const Font::GlyphData glyphData = {.advanceX = static_cast<int16_t>(glyphSlot->advance.x >> 6),
+                                       .top      = static_cast<int16_t>(glyphSlot->bitmap_top),
+                                       .left     = static_cast<int16_t>(glyphSlot->bitmap_left)};
+
+    // Bitmap.
+    const Font::GlyphBitmap glyphBitmap = {.buffer = bitmap.buffer,
+                                           .width  = static_cast<int>(bitmap.width),
+                                           .height = static_cast<int>(bitmap.rows),
+                                           .pitch  = bitmap.pitch};
+
+    return Font::insert_glyph(codepoint, glyphData, glyphBitmap);
+}
+
+uint64_t sdl3::Font::get_cache_key() const
+{
+    // FNV-1a over the hash of every file in the chain, in order. Files remember their hash, so each is only read once.
+    static constexpr uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ull;
+    static constexpr uint64_t FNV_PRIME        = 0x100000001B3ull;
+
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (const Font::FontFace &fontFace : m_faces)
     {
-        // Find the next valid breakpoint and create a substring. Even if this is npos, it will work.
-        size_t nextBreakpoint = text.find_first_of(" .", i);
-        if (nextBreakpoint != text.npos) { ++nextBreakpoint; }
-        std::string_view word{text.substr(i, nextBreakpoint - i)};
+        const uint64_t fileHash = fontFace.file->get_hash();
+        for (size_t shift = 0; shift < 64; shift += 8)
+        {
+            hash ^= (fileHash >> shift) & 0xFF;
+            hash *= FNV_PRIME;
+        }
+    }
 
-        // Get the length of the word. If we've surpassed our max, break the line.
-        const size_t wordWidth = Font::get_text_width(word);
-        if (x + wordWidth >= adjustedMax) { break_line(); }
+    return hash;
+}
 
-        // Loop through the word and render it.
-        for (const char charCode : word)
+uint32_t sdl3::Font::resolve_face(char32_t codepoint)
+{
+    const std::optional<uint32_t> knownFace = m_faceMap.find(codepoint);
+    if (knownFace.has_value()) { return *knownFace; }
+
+    // First face to have it wins. If none do, the font's own missing glyph box is used.
+    uint32_t faceIndex = m_faces.empty() ? MISSING_GLYPH : 0;
+    for (size_t i = 0; i < m_faces.size(); i++)
+    {
+        if (FT_Get_Char_Index(m_faces[i].face, codepoint) != 0)
         {
-            // Line breaking.
-            if (charCode == '\n')
-            {
-                break_line();
-                continue;
-            }
+            faceIndex = static_cast<uint32_t>(i);
+            break;
+        }
+    }
 
-            // Try to load/find the glyph. If it's not found, just continue.
-            const auto getGlyph = Font::find_load_glyph(charCode);
-            if (!getGlyph.has_value()) { continue; }
+    m_faceMap.insert(codepoint, faceIndex);
 
-            // Get the actual data.
-            const Font::GlyphData &glyphData = getGlyph->get();
+    return faceIndex;
+}
 
-            // Render color.
-            glyphData.texture->set_color_mod(renderColor);
+FT_Face sdl3::Font::open_face(FT_Library library, const sdl3::MappedFile &fontFile, int pixelSize)
+{
+    if (!library) { return nullptr; }
 
-            // Render the glyph.
-            const int renderX = x + glyphData.left;
-            const int renderY = y + (m_pixelSize - glyphData.top);
-            glyphData.texture->render(renderX, renderY);
+    const std::span<const uint8_t> fontData = fontFile.get_data();
+    FT_Face fontFace{};
+    FT_Error ftError = FT_New_Memory_Face(library, fontData.data(), static_cast<FT_Long>(fontData.size()), 0, &fontFace);
+    if (ftError != 0) { return nullptr; }
 
-            // Advance position.
-            x += glyphData.advanceX;
-        }
+    ftError = FT_Set_Pixel_Sizes(fontFace, 0, pixelSize);
+    if (ftError != 0)
+    {
+        FT_Done_Face(fontFace);
+        return nullptr;
+    }
+
+    return fontFace;
+}
+
+std::optional<uint32_t> sdl3::Font::find_glyph_index(char32_t codepoint) const noexcept
+{
+    // ASCII and Latin-1 are looked up directly. Everything else goes through the hash table.
+    if (codepoint < FLAT_GLYPH_COUNT)
+    {
+        const uint32_t flatIndex = m_flatGlyphs[codepoint];
+        if (flatIndex == 0) { return std::nullopt; }
 
-        i += word.length();
+        return flatIndex - 1;
     }
+
+    return m_glyphMap.find(codepoint);
+}
+
+sdl3::OptionalReference<sdl3::Font::GlyphData> sdl3::Font::insert_glyph(char32_t codepoint,
+                                                                        Font::GlyphData glyphData,
+                                                                        const Font::GlyphBitmap &glyphBitmap)
+{
+    // Pack it into the atlas. Glyphs like spaces have no bitmap and are only advanced over.
+    const bool hasBitmap = glyphBitmap.width > 0 && glyphBitmap.height > 0;
+    if (hasBitmap && !Font::pack_glyph_bitmap(glyphBitmap, glyphData)) { return std::nullopt; }
+
+    return Font::store_glyph(codepoint, glyphData);
 }
 
-size_t sdl3::Font::get_text_width(std::string_view text)
+sdl3::Font::GlyphData &sdl3::Font::store_glyph(char32_t codepoint, const Font::GlyphData &glyphData)
 {
-    size_t textWidth{};
-    for (const char charCode : text)
+    // The page needs to know what's on it in case it's evicted.
+    if (glyphData.source.w > 0 && glyphData.source.h > 0) { m_pages[glyphData.page].codepoints.push_back(codepoint); }
+
+    // Store it in a slot freed by an evicted glyph if there is one.
+    uint32_t glyphIndex = static_cast<uint32_t>(m_glyphs.size());
+    if (m_freeGlyphSlots.empty()) { m_glyphs.push_back(glyphData); }
+    else
     {
-        // Ignore line breaks.
-        if (charCode == '\n') { continue; }
+        glyphIndex = m_freeGlyphSlots.back();
+        m_freeGlyphSlots.pop_back();
+        m_glyphs[glyphIndex] = glyphData;
+    }
 
-        // Attempt to get glyph.
-        const auto getGlyph = Font::find_load_glyph(charCode);
-        if (!getGlyph.has_value()) { continue; }
+    // Record where it went.
+    if (codepoint < FLAT_GLYPH_COUNT) { m_flatGlyphs[codepoint] = glyphIndex + 1; }
+    else
+    {
+        m_glyphMap.insert(codepoint, glyphIndex);
+    }
 
-        // Actual glyph data.
-        const Font::GlyphData &glyphData = getGlyph->get();
+    return m_glyphs[glyphIndex];
+}
+
+void sdl3::Font::rasterize_glyphs(std::shared_ptr<Font::PreloadState> state,
+                                  std::vector<sdl3::SharedMappedFile> fontFiles,
+                                  int pixelSize,
+                                  std::vector<Font::GlyphRequest> requests)
+{
+    std::vector<Font::RasterGlyph> rasterGlyphs{};
+
+    // Freetype libraries and faces can't be shared between threads, so every job gets its own. The files themselves can be.
+    {
+        sdl3::Freetype freetype{};
+        std::vector<FT_Face> fontFaces(fontFiles.size());
+
+        for (const Font::GlyphRequest &request : requests)
+        {
+            // Faces are only opened once something needs them.
+            FT_Face &fontFace = fontFaces[request.face];
+            if (!fontFace) { fontFace = Font::open_face(freetype.get_library(), *fontFiles[request.face], pixelSize); }
+            if (!fontFace) { continue; }
 
-        // Add the advance to the text width.
-        textWidth += glyphData.advanceX;
+            const FT_UInt charIndex = FT_Get_Char_Index(fontFace, request.codepoint);
+            if (FT_Load_Glyph(fontFace, charIndex, FT_LOAD_RENDER) != 0) { continue; }
+
+            const FT_GlyphSlot glyphSlot = fontFace->glyph;
+            const FT_Bitmap &bitmap      = glyphSlot->bitmap;
+
+            Font::RasterGlyph rasterGlyph = {.codepoint = request.codepoint,
+                                             .glyphData = {.advanceX = static_cast<int16_t>(glyphSlot->advance.x >> 6),
+                                                           .top      = static_cast<int16_t>(glyphSlot->bitmap_top),
+                                                           .left     = static_cast<int16_t>(glyphSlot->bitmap_left)},
+                                             .width     = static_cast<int>(bitmap.width),
+                                             .height    = static_cast<int>(bitmap.rows)};
+
+            // Copy the coverage out tightly packed. The glyph slot is reused by the next load.
+            rasterGlyph.coverage.resize(rasterGlyph.width * rasterGlyph.height);
+            for (int row = 0; row < rasterGlyph.height; row++)
+            {
+                const uint8_t *bitmapRow = bitmap.buffer + (row * bitmap.pitch);
+                std::copy(bitmapRow, bitmapRow + rasterGlyph.width, rasterGlyph.coverage.data() + (row * rasterGlyph.width));
+            }
+
+            rasterGlyphs.push_back(std::move(rasterGlyph));
+        }
+
+        for (FT_Face fontFace : fontFaces)
+        {
+            if (fontFace) { FT_Done_Face(fontFace); }
+        }
     }
 
-    return textWidth;
+    // Hand them over.
+    {
+        std::lock_guard preloadLock{state->mutex};
+        std::move(rasterGlyphs.begin(), rasterGlyphs.end(), std::back_inserter(state->ready));
+        --state->pendingJobs;
+    }
 }
 
-//                      ---- Private Functions ----
+bool sdl3::Font::pack_glyph_bitmap(const Font::GlyphBitmap &glyphBitmap, Font::GlyphData &glyphData)
+{
+    const int width  = glyphBitmap.width;
+    const int height = glyphBitmap.height;
+
+    // Try the current page first. Older pages are usually full anyway.
+    std::optional<SDL_Rect> packedRect{};
+    size_t pageIndex = m_currentPage;
+    if (pageIndex < m_pages.size() && m_pages[pageIndex].texture)
+    {
+        packedRect = m_pages[pageIndex].packer.pack(width, height);
+    }
+
+    // Grow by a page if it didn't fit. Pages are normally a fixed size, but a glyph bigger than that gets a page of its own.
+    if (!packedRect.has_value())
+    {
+        pageIndex  = Font::create_atlas_page(std::max(ATLAS_PAGE_SIZE, width + 1), std::max(ATLAS_PAGE_SIZE, height + 1));
+        packedRect = m_pages[pageIndex].packer.pack(width, height);
+        if (!packedRect.has_value()) { return false; }
+    }
+
+    // Keep a copy of the coverage on the CPU side too. Freetype's rows can be padded, so the pitch is respected here.
+    Font::AtlasPage &page = m_pages[pageIndex];
+    page.lastUse          = sm_useClock;
+    for (int row = 0; row < height; row++)
+    {
+        const uint8_t *bitmapRow = glyphBitmap.buffer + (row * glyphBitmap.pitch);
+        uint8_t *coverageRow     = page.coverage.data() + ((packedRect->y + row) * page.packer.get_width()) + packedRect->x;
+        std::copy(bitmapRow, bitmapRow + width, coverageRow);
+    }
+
+    if (!Font::upload_coverage(page, *packedRect, glyphBitmap.buffer, glyphBitmap.pitch)) { return false; }
+
+    glyphData.page   = static_cast<uint16_t>(pageIndex);
+    glyphData.source = *packedRect;
 
-sdl3::OptionalReference<sdl3::Font::GlyphData> sdl3::Font::find_load_glyph(char charCode)
+    return true;
+}
+
+bool sdl3::Font::upload_coverage(Font::AtlasPage &page, const SDL_Rect &rect, const uint8_t *coverage, int pitch)
 {
-    // Start by searching the map for the character.
-    const auto findCharacter = m_cacheMap.find(charCode);
-    if (findCharacter != m_cacheMap.end()) { return findCharacter->second; }
+    if (!page.texture->is_initialized()) { return true; }
 
-    // Check if the character exists in the font.
-    const FT_UInt charIndex  = FT_Get_Char_Index(m_fontFace, charCode);
-    const FT_Error loadError = FT_Load_Glyph(m_fontFace, charIndex, FT_LOAD_RENDER);
-    if (loadError != 0) { return std::nullopt; }
+    // Alpha only pages take the coverage as is. Anything else needs it expanded to white pixels first.
+    if (page.alphaOnly) { return page.texture->update(&rect, coverage, pitch); }
 
-    // This makes things easier to read.
-    const FT_GlyphSlot glyphSlot = m_fontFace->glyph;
-    const FT_Bitmap glyphBitmap  = glyphSlot->bitmap;
+    // Pages are in the native format. The base pixel color is white, which makes it easier to color later.
+    const SDL_PixelFormatDetails *details = SDL_GetPixelFormatDetails(sdl3::Texture::get_native_format());
+    if (!details) { return false; }
+
+    m_expandBuffer.resize(rect.w * rect.h);
+    sdl3::pixel_ops::expand_coverage(coverage,
+                                     pitch,
+                                     m_expandBuffer.data(),
+                                     rect.w,
+                                     rect.w,
+                                     rect.h,
+                                     ~details->Amask,
+                                     details->Ashift);
+
+    return page.texture->update(&rect, m_expandBuffer.data(), rect.w * sizeof(uint32_t));
+}
+
+void sdl3::Font::make_room(size_t incomingBytes)
+{
+    auto over_budget = [incomingBytes](size_t usage, size_t budget) { return budget != 0 && usage + incomingBytes > budget; };
 
-    // Convert to texture.
-    sdl3::SharedTexture glyphTexture = Font::convert_glyph_to_texture(charCode, glyphBitmap);
+    while (true)
+    {
+        const bool overOwn    = over_budget(m_glyphMemoryUsage, m_glyphMemoryBudget);
+        const bool overShared = over_budget(sm_sharedGlyphUsage, sm_sharedGlyphBudget);
+        if (!overOwn && !overShared) { return; }
+
+        // Our own budget can only be met with our own pages. The shared one takes the coldest page of any font.
+        sdl3::Font *victimFont = nullptr;
+        size_t victimPage      = 0;
+        uint64_t oldestUse     = std::numeric_limits<uint64_t>::max();
+        auto find_coldest      = [&](sdl3::Font &font)
+        {
+            for (size_t i = 0; i < font.m_pages.size(); i++)
+            {
+                const Font::AtlasPage &page = font.m_pages[i];
+                if (!page.texture || page.lastUse == sm_useClock || page.lastUse >= oldestUse) { continue; }
+
+                victimFont = &font;
+                victimPage = i;
+                oldestUse  = page.lastUse;
+            }
+        };
 
-    // Add to cache map.
-    // Struct
-    Font::GlyphData cacheData = {.advanceX = static_cast<int16_t>(glyphSlot->advance.x >> 6),
-                                 .top      = static_cast<int16_t>(glyphSlot->bitmap_top),
-                                 .left     = static_cast<int16_t>(glyphSlot->bitmap_left),
-                                 .texture  = glyphTexture};
+        if (overOwn) { find_coldest(*this); }
+        else
+        {
+            for (sdl3::Font *font : sm_fonts) { find_coldest(*font); }
+        }
 
-    // Try emplace.
-    const auto emplacePair = m_cacheMap.try_emplace(charCode, cacheData);
-    if (!emplacePair.second) { return std::nullopt; }
+        // Everything left is in use right now.
+        if (!victimFont) { return; }
 
-    // Return the one in the cache map since the other was temporary and will die once this function finishes.
-    return m_cacheMap.at(charCode);
+        victimFont->evict_page(victimPage);
+    }
 }
 
-sdl3::SharedTexture sdl3::Font::convert_glyph_to_texture(char charCode, const FT_Bitmap glyphBitmap)
+void sdl3::Font::evict_page(size_t pageIndex)
 {
-    // The base pixel color is white. That makes it easier to color later.
-    static constexpr uint32_t BASE_PIXEL_COLOR = 0xFFFFFF00;
+    Font::AtlasPage &page = m_pages[pageIndex];
 
-    // Bitmap size. I've always found Freetype's rows instead of height confusing.
-    const size_t bitmapSize = glyphBitmap.width * glyphBitmap.rows;
+    // Forget every glyph on it. Their slots are reused by the next glyphs loaded.
+    for (const char32_t codepoint : page.codepoints)
+    {
+        const std::optional<uint32_t> glyphIndex = Font::find_glyph_index(codepoint);
+        if (!glyphIndex.has_value()) { continue; }
 
-    // Temporary surface.
-    sdl3::Surface surface = sdl3::create_new_surface_rgba(glyphBitmap.width, glyphBitmap.rows);
+        m_freeGlyphSlots.push_back(*glyphIndex);
+        if (codepoint < FLAT_GLYPH_COUNT) { m_flatGlyphs[codepoint] = 0; }
+        else
+        {
+            m_glyphMap.erase(codepoint);
+        }
+    }
+
+    m_glyphMemoryUsage -= page.memorySize;
+    sm_sharedGlyphUsage -= page.memorySize;
 
-    // Cast pointer to raw surface data.
-    uint32_t *rawSurface = reinterpret_cast<uint32_t *>(surface.get()->pixels);
+    // The slot stays so page indices don't shift. The next page created takes it over. Quads from earlier text this frame
+    // can still be sitting in the sprite batch, but the texture flushes them before it's destroyed.
+    page = Font::AtlasPage{};
 
-    // Spans for blitting. These should both be the same size.
-    std::span<uint32_t> surfacePixels{rawSurface, bitmapSize};
-    std::span<const uint8_t> bitmapPixels{glyphBitmap.buffer, bitmapSize};
+    // Cached layouts might reference it.
+    ++m_evictionGeneration;
+}
 
-    // Loop and blit.
-    for (size_t i = 0; i < bitmapSize; i++) { surfacePixels[i] = BASE_PIXEL_COLOR | bitmapPixels[i]; }
+size_t sdl3::Font::create_atlas_page(int pageWidth, int pageHeight)
+{
+    // Make room before allocating so usage never goes over the budget when it can be helped. The CPU side copy of the
+    // coverage counts too.
+    const bool indexed      = sdl3::Texture::supports_format(SDL_PIXELFORMAT_INDEX8);
+    const size_t pixelCount = static_cast<size_t>(pageWidth) * pageHeight;
+    Font::make_room(pixelCount * (indexed ? 1 : sizeof(uint32_t)) + pixelCount);
 
-    // Name for the texture manager to keep track.
-    const std::string glyphName = std::format("{}-{}", charCode, m_pixelSize);
+    Font::AtlasPage page{.packer = sdl3::AtlasPacker(pageWidth, pageHeight), .lastUse = sm_useClock};
 
-    // Return the texture. We're going to use a name here instead of a path.
-    return sdl3::TextureManager::load_resource(glyphName, surface);
-}
\ No newline at end of file
+    // Single channel pages are a quarter of the size. They need the renderer to support palettes though.
+    if (indexed)
+    {
+        page.texture =
+            std::make_shared<sdl3::Texture>(pageWidth, pageHeight, SDL_PIXELFORMAT_INDEX8, SDL_TEXTUREACCESS_STATIC);
+        page.alphaOnly = page.texture->set_palette(get_coverage_palette());
+    }
+
+    if (!page.alphaOnly)
+    {
+        page.texture = std::make_shared<sdl3::Texture>(pageWidth, pageHeight, SDL_TEXTUREACCESS_STATIC);
+    }
+
+    // New textures aren't guaranteed to be empty, so clear it once here. Without a renderer, only the CPU side exists.
+    const int bytesPerPixel = page.alphaOnly ? 1 : sizeof(uint32_t);
+    if (page.texture->is_initialized())
+    {
+        const std::vector<uint8_t> clearPixels(pixelCount * bytesPerPixel);
+        page.texture->update(nullptr, clearPixels.data(), pageWidth * bytesPerPixel);
+        page.texture->set_blend_mode(SDL_BLENDMODE_BLEND);
+        page.texture->set_scale_mode(SDL_SCALEMODE_NEAREST);
+    }
+
+    page.coverage.assign(pixelCount, 0);
+    page.memorySize = page.texture->is_initialized() ? pixelCount * bytesPerPixel + pixelCount : pixelCount;
+    m_glyphMemoryUsage += page.memorySize;
+    sm_sharedGlyphUsage += page.memorySize;
+
+    // Take over an evicted page's slot if there is one.
+    auto is_free        = [](const Font::AtlasPage &slot) { return !slot.texture; };
+    const auto freePage = std::find_if(m_pages.begin(), m_pages.end(), is_free);
+    m_currentPage       = static_cast<size_t>(freePage - m_pages.begin());
+    if (freePage != m_pages.end()) { *freePage = std::move(page); }
+    else
+    {
+        m_pages.push_back(std::move(page));
+        m_pageVertices.resize(m_pages.size());
+    }
+
+    return m_currentPage;
+}
+
+void sdl3::Font::queue_glyph(int x, int y, uint16_t page, const SDL_Rect &source, SDL_FColor color)
+{
+    // Page dimensions for the texture coordinates.
+    const sdl3::SharedTexture &pageTexture = m_pages[page].texture;
+    const float pageWidth                  = pageTexture->get_width();
+    const float pageHeight                 = pageTexture->get_height();
+
+    // Screen and texture corners.
+    const float left   = static_cast<float>(x);
+    const float top    = static_cast<float>(y);
+    const float right  = left + source.w;
+    const float bottom = top + source.h;
+    const float u0     = source.x / pageWidth;
+    const float v0     = source.y / pageHeight;
+    const float u1     = (source.x + source.w) / pageWidth;
+    const float v1     = (source.y + source.h) / pageHeight;
+
+    std::vector<SDL_Vertex> &vertices = m_pageVertices[page];
+    vertices.push_back({.position = {left, top}, .color = color, .tex_coord = {u0, v0}});
+    vertices.push_back({.position = {right, top}, .color = color, .tex_coord = {u1, v0}});
+    vertices.push_back({.position = {right, bottom}, .color = color, .tex_coord = {u1, v1}});
+    vertices.push_back({.position = {left, bottom}, .color = color, .tex_coord = {u0, v1}});
+}
+
+void sdl3::Font::flush_glyphs()
+{
+    for (size_t i = 0; i < m_pages.size(); i++)
+    {
+        std::vector<SDL_Vertex> &vertices = m_pageVertices[i];
+        if (vertices.empty()) { continue; }
+
+        m_pages[i].lastUse = sm_useClock;
+
+        // Make sure the shared index buffer covers every quad queued.
+        const size_t indexCount = (vertices.size() / 4) * 6;
+        for (size_t quad = m_quadIndices.size() / 6; m_quadIndices.size() < indexCount; quad++)
+        {
+            const int base = static_cast<int>(quad * 4);
+            m_quadIndices.insert(m_quadIndices.end(), {base, base + 1, base + 2, base + 2, base + 3, base});
+        }
+
+        m_pages[i].texture->render_geometry(vertices, std::span<const int>{m_quadIndices.data(), indexCount});
+        vertices.clear();
+    }
+}
@@ -0,0 +1,81 @@
+#include "FramePacer.hpp"
+
+#include "Renderer.hpp"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+
+//                      ---- Construction ----
+
+sdl3::FramePacer::FramePacer(double frameRate, double updateRate) noexcept
+    : m_frequency{SDL_GetPerformanceFrequency()}
+    , m_lastFrame{SDL_GetPerformanceCounter()}
+{
+    FramePacer::set_frame_rate(frameRate);
+    FramePacer::set_update_rate(updateRate);
+    m_nextFrame = m_lastFrame + m_frameTicks;
+}
+
+//                      ---- Public Functions ----
+
+bool sdl3::FramePacer::enable_vsync(sdl3::Renderer &renderer)
+{
+    m_vsync = renderer.set_vsync(1);
+    return m_vsync;
+}
+
+void sdl3::FramePacer::set_frame_rate(double frameRate) noexcept
+{
+    m_frameTicks = frameRate > 0.0 ? static_cast<uint64_t>(static_cast<double>(m_frequency) / frameRate) : 0;
+}
+
+void sdl3::FramePacer::set_update_rate(double updateRate) noexcept
+{
+    if (updateRate > 0.0) { m_updateDelta = 1.0 / updateRate; }
+}
+
+void sdl3::FramePacer::begin_frame() noexcept
+{
+    const uint64_t now = SDL_GetPerformanceCounter();
+    m_frameDelta       = static_cast<double>(now - m_lastFrame) / static_cast<double>(m_frequency);
+    m_lastFrame        = now;
+
+    // A long stall would otherwise queue up more updates than can ever be caught up on.
+    m_accumulator += std::min(m_frameDelta, MAX_FRAME_DELTA);
+}
+
+bool sdl3::FramePacer::step() noexcept
+{
+    if (m_accumulator < m_updateDelta) { return false; }
+
+    m_accumulator -= m_updateDelta;
+    return true;
+}
+
+void sdl3::FramePacer::end_frame() noexcept
+{
+    // Presenting already waited for vsync.
+    if (m_vsync || m_frameTicks == 0) { return; }
+
+    // Sleep for most of the wait, then spin the rest since sleeps can overshoot by a millisecond or more.
+    const uint64_t spinTicks = SPIN_NS * m_frequency / SDL_NS_PER_SECOND;
+    uint64_t now             = SDL_GetPerformanceCounter();
+    while (now < m_nextFrame)
+    {
+        const uint64_t remaining = m_nextFrame - now;
+        if (remaining > spinTicks) { SDL_DelayNS((remaining - spinTicks) * SDL_NS_PER_SECOND / m_frequency); }
+        now = SDL_GetPerformanceCounter();
+    }
+
+    // Deadlines are spaced evenly so small overshoots don't add up. A frame that ran long starts the schedule over.
+    m_nextFrame += m_frameTicks;
+    if (m_nextFrame < now) { m_nextFrame = now + m_frameTicks; }
+}
+
+double sdl3::FramePacer::get_update_delta() const noexcept { return m_updateDelta; }
+
+double sdl3::FramePacer::get_alpha() const noexcept { return m_updateDelta > 0.0 ? m_accumulator / m_updateDelta : 0.0; }
+
+double sdl3::FramePacer::get_frame_delta() const noexcept { return m_frameDelta; }
+
+bool sdl3::FramePacer::is_vsync() const noexcept { return m_vsync; }
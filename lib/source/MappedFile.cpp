@@ -0,0 +1,104 @@
+#include "MappedFile.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define MAPPED_FILE_USE_MMAP
+#endif
+
+//                      ---- Construction ----
+
+sdl3::MappedFile::MappedFile(std::string_view filePath)
+{
+    // Map it if we can. Otherwise, just read the entire thing.
+    if (!MappedFile::map_file(filePath) && !MappedFile::read_file(filePath)) { return; }
+
+    m_initialized = true;
+}
+
+sdl3::MappedFile::~MappedFile()
+{
+#ifdef MAPPED_FILE_USE_MMAP
+    if (m_isMapped) { munmap(const_cast<uint8_t *>(m_data), m_size); }
+#endif
+}
+
+//                      ---- Public Functions ----
+
+std::span<const uint8_t> sdl3::MappedFile::get_data() const noexcept { return {m_data, m_size}; }
+
+uint64_t sdl3::MappedFile::get_hash() const
+{
+    static constexpr uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ull;
+    static constexpr uint64_t FNV_PRIME        = 0x100000001B3ull;
+
+    std::call_once(m_hashOnce,
+                   [this]()
+                   {
+                       uint64_t hash = FNV_OFFSET_BASIS;
+                       for (const uint8_t byte : MappedFile::get_data())
+                       {
+                           hash ^= byte;
+                           hash *= FNV_PRIME;
+                       }
+                       m_hash = hash;
+                   });
+
+    return m_hash;
+}
+
+//                      ---- Private Functions ----
+
+bool sdl3::MappedFile::map_file(std::string_view filePath)
+{
+#ifdef MAPPED_FILE_USE_MMAP
+    // string_view isn't guaranteed to be terminated.
+    const std::string path{filePath};
+
+    const int fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) { return false; }
+
+    // Get the size and map it. The descriptor isn't needed once the mapping exists.
+    struct stat fileStat{};
+    const bool statted = fstat(fileDescriptor, &fileStat) == 0 && fileStat.st_size > 0;
+    void *mapping      = statted ? mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0) : MAP_FAILED;
+    close(fileDescriptor);
+    if (mapping == MAP_FAILED) { return false; }
+
+    m_data     = static_cast<const uint8_t *>(mapping);
+    m_size     = static_cast<size_t>(fileStat.st_size);
+    m_isMapped = true;
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool sdl3::MappedFile::read_file(std::string_view filePath)
+{
+    // Attempt to get the file size.
+    std::error_code error{};
+    const size_t fileSize = std::filesystem::file_size(filePath, error);
+    if (error || fileSize == 0) { return false; }
+
+    // Open the file for reading.
+    std::ifstream file{std::string{filePath}, std::ios::binary};
+    if (!file.is_open()) { return false; }
+
+    // Read it to buffer.
+    m_buffer = std::make_unique<uint8_t[]>(fileSize);
+    file.read(reinterpret_cast<char *>(m_buffer.get()), fileSize);
+    if (static_cast<size_t>(file.gcount()) != fileSize) { return false; }
+
+    m_data = m_buffer.get();
+    m_size = fileSize;
+
+    return true;
+}
@@ -0,0 +1,235 @@
+#include "ParticleSystem.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <span>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PARTICLE_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define PARTICLE_NEON
+#endif
+
+namespace
+{
+    /// @brief Adds value to every element of dest.
+    void add_constant(float *dest, float value, size_t count) noexcept
+    {
+        size_t i = 0;
+
+#if defined(PARTICLE_SSE2)
+        const __m128 valueVector = _mm_set1_ps(value);
+        for (; i + 4 <= count; i += 4) { _mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), valueVector)); }
+#elif defined(PARTICLE_NEON)
+        const float32x4_t valueVector = vdupq_n_f32(value);
+        for (; i + 4 <= count; i += 4) { vst1q_f32(dest + i, vaddq_f32(vld1q_f32(dest + i), valueVector)); }
+#endif
+
+        // Whatever is left over.
+        for (; i < count; i++) { dest[i] += value; }
+    }
+
+    /// @brief Adds source scaled by scale to dest.
+    void add_scaled(float *dest, const float *source, float scale, size_t count) noexcept
+    {
+        size_t i = 0;
+
+#if defined(PARTICLE_SSE2)
+        const __m128 scaleVector = _mm_set1_ps(scale);
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 scaled = _mm_mul_ps(_mm_loadu_ps(source + i), scaleVector);
+            _mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), scaled));
+        }
+#elif defined(PARTICLE_NEON)
+        const float32x4_t scaleVector = vdupq_n_f32(scale);
+        for (; i + 4 <= count; i += 4)
+        {
+            vst1q_f32(dest + i, vmlaq_f32(vld1q_f32(dest + i), vld1q_f32(source + i), scaleVector));
+        }
+#endif
+
+        // Whatever is left over.
+        for (; i < count; i++) { dest[i] += source[i] * scale; }
+    }
+
+    /// @brief Adds source scaled by scale to dest and clamps the result between 0 and 1.
+    void add_scaled_clamped(float *dest, const float *source, float scale, size_t count) noexcept
+    {
+        size_t i = 0;
+
+#if defined(PARTICLE_SSE2)
+        const __m128 scaleVector = _mm_set1_ps(scale);
+        const __m128 zero        = _mm_setzero_ps();
+        const __m128 one         = _mm_set1_ps(1.0f);
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 sum = _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(source + i), scaleVector));
+            _mm_storeu_ps(dest + i, _mm_min_ps(_mm_max_ps(sum, zero), one));
+        }
+#elif defined(PARTICLE_NEON)
+        const float32x4_t scaleVector = vdupq_n_f32(scale);
+        const float32x4_t zero        = vdupq_n_f32(0.0f);
+        const float32x4_t one         = vdupq_n_f32(1.0f);
+        for (; i + 4 <= count; i += 4)
+        {
+            const float32x4_t sum = vmlaq_f32(vld1q_f32(dest + i), vld1q_f32(source + i), scaleVector);
+            vst1q_f32(dest + i, vminq_f32(vmaxq_f32(sum, zero), one));
+        }
+#endif
+
+        // Whatever is left over.
+        for (; i < count; i++) { dest[i] = std::clamp(dest[i] + source[i] * scale, 0.0f, 1.0f); }
+    }
+}
+
+//                      ---- Construction ----
+
+sdl3::ParticleSystem::ParticleSystem(size_t capacity, sdl3::SharedTexture texture)
+    : m_capacity{capacity}
+    , m_streams(capacity * STREAM_COUNT)
+    , m_texture{std::move(texture)}
+    , m_vertices(capacity * 4)
+{
+    // Every quad uses the same pattern offset by four vertices.
+    static constexpr int QUAD_INDICES[] = {0, 1, 2, 2, 3, 0};
+
+    m_indices.reserve(capacity * std::size(QUAD_INDICES));
+    for (size_t i = 0; i < capacity; i++)
+    {
+        for (const int index : QUAD_INDICES) { m_indices.push_back(static_cast<int>(i * 4) + index); }
+    }
+}
+
+//                      ---- Public Functions ----
+
+void sdl3::ParticleSystem::set_texture(sdl3::SharedTexture texture) noexcept { m_texture = std::move(texture); }
+
+void sdl3::ParticleSystem::set_gravity(float x, float y) noexcept
+{
+    m_gravityX = x;
+    m_gravityY = y;
+}
+
+bool sdl3::ParticleSystem::spawn(const sdl3::ParticleSpawn &spawn) noexcept
+{
+    if (m_count >= m_capacity) { return false; }
+
+    const float values[STREAM_COUNT] = {spawn.x,
+                                        spawn.y,
+                                        spawn.velocityX,
+                                        spawn.velocityY,
+                                        spawn.lifetime,
+                                        spawn.size,
+                                        spawn.color.r,
+                                        spawn.color.g,
+                                        spawn.color.b,
+                                        spawn.color.a,
+                                        spawn.fade.r,
+                                        spawn.fade.g,
+                                        spawn.fade.b,
+                                        spawn.fade.a};
+
+    for (size_t stream = 0; stream < STREAM_COUNT; stream++) { m_streams[stream * m_capacity + m_count] = values[stream]; }
+    ++m_count;
+
+    return true;
+}
+
+void sdl3::ParticleSystem::update(float deltaTime) noexcept
+{
+    if (m_count == 0) { return; }
+
+    // Gravity changes velocity, then velocity changes position.
+    float *velocityX = ParticleSystem::get_stream(Stream::VelocityX);
+    float *velocityY = ParticleSystem::get_stream(Stream::VelocityY);
+    if (m_gravityX != 0.0f) { add_constant(velocityX, m_gravityX * deltaTime, m_count); }
+    if (m_gravityY != 0.0f) { add_constant(velocityY, m_gravityY * deltaTime, m_count); }
+
+    add_scaled(ParticleSystem::get_stream(Stream::X), velocityX, deltaTime, m_count);
+    add_scaled(ParticleSystem::get_stream(Stream::Y), velocityY, deltaTime, m_count);
+    add_constant(ParticleSystem::get_stream(Stream::Life), -deltaTime, m_count);
+
+    // The color streams are back to back, and so are the fades.
+    float *color      = ParticleSystem::get_stream(Stream::Red);
+    const float *fade = ParticleSystem::get_stream(Stream::FadeRed);
+    for (size_t channel = 0; channel < CHANNEL_COUNT; channel++)
+    {
+        add_scaled_clamped(color + channel * m_capacity, fade + channel * m_capacity, deltaTime, m_count);
+    }
+
+    ParticleSystem::remove_dead();
+}
+
+bool sdl3::ParticleSystem::render()
+{
+    if (!m_texture || !m_texture->is_initialized()) { return false; }
+    if (m_count == 0) { return true; }
+
+    const float *x     = ParticleSystem::get_stream(Stream::X);
+    const float *y     = ParticleSystem::get_stream(Stream::Y);
+    const float *size  = ParticleSystem::get_stream(Stream::Size);
+    const float *red   = ParticleSystem::get_stream(Stream::Red);
+    const float *green = ParticleSystem::get_stream(Stream::Green);
+    const float *blue  = ParticleSystem::get_stream(Stream::Blue);
+    const float *alpha = ParticleSystem::get_stream(Stream::Alpha);
+
+    // Premultiplied textures need the vertex color premultiplied too, or particles would brighten as they fade.
+    const bool premultiplied = m_texture->is_premultiplied();
+    for (size_t i = 0; i < m_count; i++)
+    {
+        const float half   = size[i] * 0.5f;
+        const float left   = x[i] - half;
+        const float top    = y[i] - half;
+        const float right  = x[i] + half;
+        const float bottom = y[i] + half;
+        const float scale  = premultiplied ? alpha[i] : 1.0f;
+
+        const SDL_FColor color = {.r = red[i] * scale, .g = green[i] * scale, .b = blue[i] * scale, .a = alpha[i]};
+
+        SDL_Vertex *quad = m_vertices.data() + i * 4;
+        quad[0]          = {.position = {left, top}, .color = color, .tex_coord = {0.0f, 0.0f}};
+        quad[1]          = {.position = {right, top}, .color = color, .tex_coord = {1.0f, 0.0f}};
+        quad[2]          = {.position = {right, bottom}, .color = color, .tex_coord = {1.0f, 1.0f}};
+        quad[3]          = {.position = {left, bottom}, .color = color, .tex_coord = {0.0f, 1.0f}};
+    }
+
+    const std::span<const SDL_Vertex> vertices = std::span<const SDL_Vertex>{m_vertices}.first(m_count * 4);
+    const std::span<const int> indices         = std::span<const int>{m_indices}.first(m_count * 6);
+
+    return m_texture->render_geometry(vertices, indices);
+}
+
+void sdl3::ParticleSystem::clear() noexcept { m_count = 0; }
+
+size_t sdl3::ParticleSystem::size() const noexcept { return m_count; }
+
+size_t sdl3::ParticleSystem::get_capacity() const noexcept { return m_capacity; }
+
+//                      ---- Private Functions ----
+
+float *sdl3::ParticleSystem::get_stream(ParticleSystem::Stream stream) noexcept
+{ return m_streams.data() + static_cast<size_t>(stream) * m_capacity; }
+
+void sdl3::ParticleSystem::remove_dead() noexcept
+{
+    const float *life = ParticleSystem::get_stream(Stream::Life);
+    for (size_t i = 0; i < m_count;)
+    {
+        if (life[i] > 0.0f)
+        {
+            ++i;
+            continue;
+        }
+
+        // The last particle takes this one's place, so the same slot gets checked again.
+        --m_count;
+        for (size_t stream = 0; stream < STREAM_COUNT; stream++)
+        {
+            float *values = m_streams.data() + stream * m_capacity;
+            values[i]     = values[m_count];
+        }
+    }
+}
@@ -0,0 +1,331 @@
+#include "PixelOps.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PIXEL_OPS_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define PIXEL_OPS_NEON
+#endif
+
+namespace
+{
+    /// @brief Expands a single row of coverage.
+    void expand_coverage_row(const uint8_t *source, uint32_t *dest, int width, uint32_t baseColor, int alphaShift) noexcept
+    {
+        int column = 0;
+
+#if defined(PIXEL_OPS_SSE2)
+        // Sixteen pixels at a time. Bytes are zero extended to 32 bits, then shifted into place.
+        const __m128i zero  = _mm_setzero_si128();
+        const __m128i base  = _mm_set1_epi32(static_cast<int>(baseColor));
+        const __m128i shift = _mm_cvtsi32_si128(alphaShift);
+        for (; column + 16 <= width; column += 16)
+        {
+            const __m128i coverage = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + column));
+            const __m128i low      = _mm_unpacklo_epi8(coverage, zero);
+            const __m128i high     = _mm_unpackhi_epi8(coverage, zero);
+
+            __m128i *destVector = reinterpret_cast<__m128i *>(dest + column);
+            _mm_storeu_si128(destVector + 0, _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(low, zero), shift), base));
+            _mm_storeu_si128(destVector + 1, _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(low, zero), shift), base));
+            _mm_storeu_si128(destVector + 2, _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(high, zero), shift), base));
+            _mm_storeu_si128(destVector + 3, _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(high, zero), shift), base));
+        }
+#elif defined(PIXEL_OPS_NEON)
+        // Sixteen pixels at a time. Bytes are widened to 32 bits, then shifted into place.
+        const uint32x4_t base = vdupq_n_u32(baseColor);
+        const int32x4_t shift = vdupq_n_s32(alphaShift);
+        for (; column + 16 <= width; column += 16)
+        {
+            const uint8x16_t coverage = vld1q_u8(source + column);
+            const uint16x8_t low      = vmovl_u8(vget_low_u8(coverage));
+            const uint16x8_t high     = vmovl_u8(vget_high_u8(coverage));
+
+            vst1q_u32(dest + column + 0, vorrq_u32(vshlq_u32(vmovl_u16(vget_low_u16(low)), shift), base));
+            vst1q_u32(dest + column + 4, vorrq_u32(vshlq_u32(vmovl_u16(vget_high_u16(low)), shift), base));
+            vst1q_u32(dest + column + 8, vorrq_u32(vshlq_u32(vmovl_u16(vget_low_u16(high)), shift), base));
+            vst1q_u32(dest + column + 12, vorrq_u32(vshlq_u32(vmovl_u16(vget_high_u16(high)), shift), base));
+        }
+#endif
+
+        // Whatever is left over.
+        for (; column < width; column++) { dest[column] = baseColor | (static_cast<uint32_t>(source[column]) << alphaShift); }
+    }
+
+    /// @brief Divides by 255 with rounding without actually dividing. Exact for anything up to 255 * 255.
+    constexpr uint32_t divide_255(uint32_t value) noexcept
+    {
+        const uint32_t rounded = value + 128;
+        return (rounded + (rounded >> 8)) >> 8;
+    }
+
+#if defined(PIXEL_OPS_SSE2)
+    /// @brief SSE2 version of divide_255 for eight 16 bit lanes.
+    inline __m128i divide_255(__m128i value) noexcept
+    {
+        const __m128i rounded = _mm_add_epi16(value, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(rounded, _mm_srli_epi16(rounded, 8)), 8);
+    }
+#elif defined(PIXEL_OPS_NEON)
+    /// @brief Lerps eight bytes of dest towards color by the weights passed.
+    inline uint8x8_t lerp_bytes(uint8x8_t dest, uint8x8_t color, uint8x8_t weight) noexcept
+    {
+        const uint16x8_t sum     = vmlal_u8(vmull_u8(color, weight), dest, vmvn_u8(weight));
+        const uint16x8_t rounded = vaddq_u16(sum, vdupq_n_u16(128));
+        return vshrn_n_u16(vaddq_u16(rounded, vshrq_n_u16(rounded, 8)), 8);
+    }
+#endif
+
+    /// @brief Blends a single row of coverage.
+    void blend_coverage_row(const uint8_t *source, uint32_t *dest, int width, uint32_t color, uint8_t alpha) noexcept
+    {
+        int column = 0;
+
+#if defined(PIXEL_OPS_SSE2)
+        // Four pixels at a time. Every channel is lerped towards the color with 16 bit math.
+        const __m128i zero        = _mm_setzero_si128();
+        const __m128i alphaVector = _mm_set1_epi16(alpha);
+        const __m128i maxVector   = _mm_set1_epi16(255);
+        const __m128i colorVector = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color)), zero);
+        for (; column + 4 <= width; column += 4)
+        {
+            // Empty coverage is common around glyphs, so it's skipped outright.
+            uint32_t coverage{};
+            std::memcpy(&coverage, source + column, sizeof(coverage));
+            if (coverage == 0) { continue; }
+
+            // Weights for the four pixels, spread across their four channels.
+            const __m128i coverageWords = _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(coverage)), zero);
+            const __m128i weights       = divide_255(_mm_mullo_epi16(coverageWords, alphaVector));
+            const __m128i weightPairs   = _mm_unpacklo_epi16(weights, weights);
+            const __m128i weightsLow    = _mm_unpacklo_epi32(weightPairs, weightPairs);
+            const __m128i weightsHigh   = _mm_unpackhi_epi32(weightPairs, weightPairs);
+
+            __m128i *destVector   = reinterpret_cast<__m128i *>(dest + column);
+            const __m128i pixels  = _mm_loadu_si128(destVector);
+            const __m128i lowSum  = _mm_add_epi16(_mm_mullo_epi16(colorVector, weightsLow),
+                                                 _mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero),
+                                                                 _mm_sub_epi16(maxVector, weightsLow)));
+            const __m128i highSum = _mm_add_epi16(_mm_mullo_epi16(colorVector, weightsHigh),
+                                                  _mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero),
+                                                                  _mm_sub_epi16(maxVector, weightsHigh)));
+
+            _mm_storeu_si128(destVector, _mm_packus_epi16(divide_255(lowSum), divide_255(highSum)));
+        }
+#elif defined(PIXEL_OPS_NEON)
+        // Eight pixels at a time. Weights are computed for all eight and then spread across their channels.
+        const uint8x8_t alphaVector = vdup_n_u8(alpha);
+        const uint8x8_t colorVector = vreinterpret_u8_u32(vdup_n_u32(color));
+        for (; column + 8 <= width; column += 8)
+        {
+            const uint8x8_t coverage = vld1_u8(source + column);
+            if (vget_lane_u64(vreinterpret_u64_u8(coverage), 0) == 0) { continue; }
+
+            const uint16x8_t scaled  = vmull_u8(coverage, alphaVector);
+            const uint16x8_t rounded = vaddq_u16(scaled, vdupq_n_u16(128));
+            const uint8x8_t weights  = vshrn_n_u16(vaddq_u16(rounded, vshrq_n_u16(rounded, 8)), 8);
+
+            const uint8x8x2_t weightPairs = vzip_u8(weights, weights);
+            const uint8x8x2_t weightsLow  = vzip_u8(weightPairs.val[0], weightPairs.val[0]);
+            const uint8x8x2_t weightsHigh = vzip_u8(weightPairs.val[1], weightPairs.val[1]);
+
+            uint8_t *destBytes       = reinterpret_cast<uint8_t *>(dest + column);
+            const uint8x16_t pixelsA = vld1q_u8(destBytes);
+            const uint8x16_t pixelsB = vld1q_u8(destBytes + 16);
+
+            vst1q_u8(destBytes,
+                     vcombine_u8(lerp_bytes(vget_low_u8(pixelsA), colorVector, weightsLow.val[0]),
+                                 lerp_bytes(vget_high_u8(pixelsA), colorVector, weightsLow.val[1])));
+            vst1q_u8(destBytes + 16,
+                     vcombine_u8(lerp_bytes(vget_low_u8(pixelsB), colorVector, weightsHigh.val[0]),
+                                 lerp_bytes(vget_high_u8(pixelsB), colorVector, weightsHigh.val[1])));
+        }
+#endif
+
+        // Whatever is left over.
+        for (; column < width; column++)
+        {
+            const uint32_t weight = divide_255(static_cast<uint32_t>(source[column]) * alpha);
+            if (weight == 0) { continue; }
+
+            const uint32_t pixel = dest[column];
+            uint32_t blended{};
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                const uint32_t colorChannel = (color >> shift) & 0xFF;
+                const uint32_t destChannel  = (pixel >> shift) & 0xFF;
+                blended |= divide_255((colorChannel * weight) + (destChannel * (255 - weight))) << shift;
+            }
+            dest[column] = blended;
+        }
+    }
+
+#if defined(PIXEL_OPS_SSE2)
+    /// @brief Multiplies the color channels of four pixels by their alpha. Alpha itself is left alone.
+    inline __m128i premultiply_pixels(__m128i pixels, __m128i alphaShift, __m128i alphaMask) noexcept
+    {
+        // Each pixel's alpha is copied into both halves of its 32 bits, then spread across its four channels.
+        const __m128i zero = _mm_setzero_si128();
+        __m128i alpha      = _mm_and_si128(_mm_srl_epi32(pixels, alphaShift), _mm_set1_epi32(0xFF));
+        alpha              = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+
+        const __m128i low    = _mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), _mm_unpacklo_epi32(alpha, alpha));
+        const __m128i high   = _mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), _mm_unpackhi_epi32(alpha, alpha));
+        const __m128i scaled = _mm_packus_epi16(divide_255(low), divide_255(high));
+
+        return _mm_or_si128(_mm_andnot_si128(alphaMask, scaled), _mm_and_si128(alphaMask, pixels));
+    }
+#elif defined(PIXEL_OPS_NEON)
+    /// @brief Multiplies sixteen bytes by sixteen alphas.
+    inline uint8x16_t premultiply_bytes(uint8x16_t channel, uint8x16_t alpha) noexcept
+    {
+        const uint16x8_t low  = vaddq_u16(vmull_u8(vget_low_u8(channel), vget_low_u8(alpha)), vdupq_n_u16(128));
+        const uint16x8_t high = vaddq_u16(vmull_u8(vget_high_u8(channel), vget_high_u8(alpha)), vdupq_n_u16(128));
+        return vcombine_u8(vshrn_n_u16(vaddq_u16(low, vshrq_n_u16(low, 8)), 8),
+                           vshrn_n_u16(vaddq_u16(high, vshrq_n_u16(high, 8)), 8));
+    }
+#endif
+
+    /// @brief Converts a single row of pixels.
+    void convert_row(const uint32_t *source,
+                     uint32_t *dest,
+                     int width,
+                     const sdl3::pixel_ops::PixelLayout &from,
+                     const sdl3::pixel_ops::PixelLayout &to,
+                     bool premultiply) noexcept
+    {
+        const int fromShifts[4] = {from.redShift, from.greenShift, from.blueShift, from.alphaShift};
+        const int toShifts[4]   = {to.redShift, to.greenShift, to.blueShift, to.alphaShift};
+        const bool sameLayout   = std::equal(std::begin(fromShifts), std::end(fromShifts), std::begin(toShifts));
+
+        int column = 0;
+
+#if defined(PIXEL_OPS_SSE2)
+        // Four pixels at a time. Each channel is shifted down, masked and shifted into its new spot.
+        const __m128i byteMask   = _mm_set1_epi32(0xFF);
+        const __m128i alphaMask  = _mm_set1_epi32(static_cast<int>(0xFFu << to.alphaShift));
+        const __m128i alphaShift = _mm_cvtsi32_si128(to.alphaShift);
+        __m128i fromCounts[4];
+        __m128i toCounts[4];
+        for (int channel = 0; channel < 4; channel++)
+        {
+            fromCounts[channel] = _mm_cvtsi32_si128(fromShifts[channel]);
+            toCounts[channel]   = _mm_cvtsi32_si128(toShifts[channel]);
+        }
+
+        for (; column + 4 <= width; column += 4)
+        {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + column));
+            if (!sameLayout)
+            {
+                __m128i moved = _mm_setzero_si128();
+                for (int channel = 0; channel < 4; channel++)
+                {
+                    const __m128i value = _mm_and_si128(_mm_srl_epi32(pixels, fromCounts[channel]), byteMask);
+                    moved               = _mm_or_si128(moved, _mm_sll_epi32(value, toCounts[channel]));
+                }
+                pixels = moved;
+            }
+
+            if (premultiply) { pixels = premultiply_pixels(pixels, alphaShift, alphaMask); }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + column), pixels);
+        }
+#elif defined(PIXEL_OPS_NEON)
+        // Sixteen pixels at a time. Loading splits the channels into separate registers, so reordering is free.
+        const int alphaPlane = to.alphaShift / 8;
+        for (; column + 16 <= width; column += 16)
+        {
+            const uint8x16x4_t pixels = vld4q_u8(reinterpret_cast<const uint8_t *>(source + column));
+
+            uint8x16x4_t converted;
+            for (int channel = 0; channel < 4; channel++)
+            {
+                converted.val[toShifts[channel] / 8] = pixels.val[fromShifts[channel] / 8];
+            }
+
+            if (premultiply)
+            {
+                const uint8x16_t alpha = converted.val[alphaPlane];
+                for (int plane = 0; plane < 4; plane++)
+                {
+                    if (plane != alphaPlane) { converted.val[plane] = premultiply_bytes(converted.val[plane], alpha); }
+                }
+            }
+            vst4q_u8(reinterpret_cast<uint8_t *>(dest + column), converted);
+        }
+#endif
+
+        // Whatever is left over.
+        for (; column < width; column++)
+        {
+            uint32_t converted{};
+            for (int channel = 0; channel < 4; channel++)
+            {
+                converted |= ((source[column] >> fromShifts[channel]) & 0xFF) << toShifts[channel];
+            }
+
+            if (premultiply)
+            {
+                const uint32_t alpha = (converted >> to.alphaShift) & 0xFF;
+                uint32_t scaled      = alpha << to.alphaShift;
+                for (int channel = 0; channel < 3; channel++)
+                {
+                    scaled |= divide_255(((converted >> toShifts[channel]) & 0xFF) * alpha) << toShifts[channel];
+                }
+                converted = scaled;
+            }
+            dest[column] = converted;
+        }
+    }
+}
+
+void sdl3::pixel_ops::expand_coverage(const uint8_t *source,
+                                      int sourcePitch,
+                                      uint32_t *dest,
+                                      int destPitch,
+                                      int width,
+                                      int height,
+                                      uint32_t baseColor,
+                                      int alphaShift) noexcept
+{
+    for (int row = 0; row < height; row++)
+    {
+        expand_coverage_row(source + (row * sourcePitch), dest + (row * destPitch), width, baseColor, alphaShift);
+    }
+}
+
+void sdl3::pixel_ops::blend_coverage(const uint8_t *source,
+                                     int sourcePitch,
+                                     uint32_t *dest,
+                                     int destPitch,
+                                     int width,
+                                     int height,
+                                     uint32_t color,
+                                     uint8_t alpha) noexcept
+{
+    for (int row = 0; row < height; row++)
+    {
+        blend_coverage_row(source + (row * sourcePitch), dest + (row * destPitch), width, color, alpha);
+    }
+}
+
+void sdl3::pixel_ops::convert_pixels(const uint32_t *source,
+                                     int sourcePitch,
+                                     uint32_t *dest,
+                                     int destPitch,
+                                     int width,
+                                     int height,
+                                     const sdl3::pixel_ops::PixelLayout &sourceLayout,
+                                     const sdl3::pixel_ops::PixelLayout &destLayout,
+                                     bool premultiply) noexcept
+{
+    for (int row = 0; row < height; row++)
+    {
+        convert_row(source + (row * sourcePitch), dest + (row * destPitch), width, sourceLayout, destLayout, premultiply);
+    }
+}
@@ -0,0 +1,88 @@
+#include "RenderState.hpp"
+
+#include "RenderStats.hpp"
+
+//                      ---- Construction ----
+
+//                      ---- Public Functions ----
+
+bool sdl3::RenderState::set_draw_color(SDL_Renderer *renderer, SDL_Color color)
+{
+    const bool same = color.r == m_drawColor.r && color.g == m_drawColor.g && color.b == m_drawColor.b &&
+                      color.a == m_drawColor.a;
+    if (m_drawColorKnown && same)
+    {
+        RENDER_STATS_ADD(elidedCalls);
+        return true;
+    }
+
+    m_drawColorKnown = SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    m_drawColor      = color;
+
+    return m_drawColorKnown;
+}
+
+bool sdl3::RenderState::set_draw_blend_mode(SDL_Renderer *renderer, SDL_BlendMode blendMode)
+{
+    if (m_drawBlendModeKnown && blendMode == m_drawBlendMode)
+    {
+        RENDER_STATS_ADD(elidedCalls);
+        return true;
+    }
+
+    m_drawBlendModeKnown = SDL_SetRenderDrawBlendMode(renderer, blendMode);
+    m_drawBlendMode      = blendMode;
+
+    return m_drawBlendModeKnown;
+}
+
+bool sdl3::RenderState::set_target(SDL_Renderer *renderer, SDL_Texture *target)
+{
+    if (RenderState::is_target(target))
+    {
+        RENDER_STATS_ADD(elidedCalls);
+        return true;
+    }
+
+    RENDER_STATS_ADD(targetSwitches);
+    m_targetKnown = SDL_SetRenderTarget(renderer, target);
+    m_target      = target;
+
+    // SDL keeps a clip rect per target, so the one we knew about doesn't apply anymore.
+    m_clipKnown = false;
+
+    return m_targetKnown;
+}
+
+bool sdl3::RenderState::set_clip(SDL_Renderer *renderer, const SDL_Rect *clip)
+{
+    if (RenderState::is_clip(clip))
+    {
+        RENDER_STATS_ADD(elidedCalls);
+        return true;
+    }
+
+    m_clipKnown   = SDL_SetRenderClipRect(renderer, clip);
+    m_clipEnabled = clip != nullptr;
+    if (clip) { m_clip = *clip; }
+
+    return m_clipKnown;
+}
+
+bool sdl3::RenderState::is_target(SDL_Texture *target) const noexcept { return m_targetKnown && target == m_target; }
+
+bool sdl3::RenderState::is_clip(const SDL_Rect *clip) const noexcept
+{
+    if (!m_clipKnown) { return false; }
+    if (!clip) { return !m_clipEnabled; }
+
+    return m_clipEnabled && clip->x == m_clip.x && clip->y == m_clip.y && clip->w == m_clip.w && clip->h == m_clip.h;
+}
+
+void sdl3::RenderState::invalidate() noexcept
+{
+    m_drawColorKnown     = false;
+    m_drawBlendModeKnown = false;
+    m_targetKnown        = false;
+    m_clipKnown          = false;
+}
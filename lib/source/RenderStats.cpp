@@ -0,0 +1,99 @@
+#include "RenderStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+//                      ---- Construction ----
+
+//                      ---- Public Functions ----
+
+void sdl3::RenderStats::frame_begin() noexcept
+{
+    sm_current     = {};
+    sm_lastTexture = nullptr;
+    sm_frameStart  = SDL_GetPerformanceCounter();
+}
+
+void sdl3::RenderStats::frame_end() noexcept
+{
+    const uint64_t elapsed = SDL_GetPerformanceCounter() - sm_frameStart;
+    sm_frameTime           = static_cast<double>(elapsed) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    sm_lastFrame           = sm_current;
+
+    // The frame falling out of the window comes out of the histogram.
+    if (sm_frameCount == FRAME_WINDOW) { --sm_histogram[sm_frameBuckets[sm_frameIndex]]; }
+    else
+    {
+        ++sm_frameCount;
+    }
+
+    const size_t bucket = std::min(static_cast<size_t>(sm_frameTime / BUCKET_WIDTH), BUCKET_COUNT - 1);
+    ++sm_histogram[bucket];
+    sm_frameBuckets[sm_frameIndex] = static_cast<uint16_t>(bucket);
+    sm_frameIndex                  = (sm_frameIndex + 1) % FRAME_WINDOW;
+}
+
+void sdl3::RenderStats::record_draw(SDL_Texture *texture, size_t vertexCount) noexcept
+{
+    ++sm_current.drawCalls;
+    sm_current.vertices += vertexCount;
+
+    if (texture != sm_lastTexture)
+    {
+        ++sm_current.textureBinds;
+        sm_lastTexture = texture;
+    }
+}
+
+sdl3::RenderCounters &sdl3::RenderStats::get_current_counters() noexcept { return sm_current; }
+
+const sdl3::RenderCounters &sdl3::RenderStats::get_frame_counters() noexcept { return sm_lastFrame; }
+
+double sdl3::RenderStats::get_frame_time() noexcept { return sm_frameTime; }
+
+double sdl3::RenderStats::get_frame_time_percentile(double percentile) noexcept
+{
+    if (sm_frameCount == 0) { return 0.0; }
+
+    // Walk the buckets until enough frames are covered.
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    const size_t rank    = std::max<size_t>(1, static_cast<size_t>(std::ceil(clamped / 100.0 * sm_frameCount)));
+
+    size_t covered{};
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        covered += sm_histogram[i];
+        if (covered >= rank) { return (i + 1) * BUCKET_WIDTH; }
+    }
+
+    return BUCKET_COUNT * BUCKET_WIDTH;
+}
+
+std::string sdl3::RenderStats::to_json()
+{
+    return std::format("{{\"drawCalls\":{},\"textureBinds\":{},\"modChanges\":{},\"targetSwitches\":{},\"vertices\":{},"
+                       "\"elidedCalls\":{},\"frameTime\":{:.3f},\"p50\":{:.2f},\"p95\":{:.2f},\"p99\":{:.2f},\"frames\":{}}}",
+                       sm_lastFrame.drawCalls,
+                       sm_lastFrame.textureBinds,
+                       sm_lastFrame.modChanges,
+                       sm_lastFrame.targetSwitches,
+                       sm_lastFrame.vertices,
+                       sm_lastFrame.elidedCalls,
+                       sm_frameTime,
+                       RenderStats::get_frame_time_percentile(50.0),
+                       RenderStats::get_frame_time_percentile(95.0),
+                       RenderStats::get_frame_time_percentile(99.0),
+                       sm_frameCount);
+}
+
+void sdl3::RenderStats::reset() noexcept
+{
+    sm_current     = {};
+    sm_lastFrame   = {};
+    sm_lastTexture = nullptr;
+    sm_frameTime   = 0.0;
+    sm_frameIndex  = 0;
+    sm_frameCount  = 0;
+    sm_histogram.fill(0);
+}
@@ -1,5 +1,26 @@
 #include "Renderer.hpp"
 
+#include "RenderStats.hpp"
+#include "TextureLoader.hpp"
+
+#include <cmath>
+
+namespace
+{
+    /// @brief Returns whether or not the number of colors works for the number of primitives passed.
+    bool colors_match(size_t primitiveCount, size_t colorCount) noexcept
+    {
+        return colorCount == primitiveCount || (colorCount == 1 && primitiveCount > 0);
+    }
+
+    /// @brief Returns the color of the primitive at the index passed as a vertex color.
+    SDL_FColor get_primitive_color(std::span<const SDL_Color> colors, size_t index) noexcept
+    {
+        const SDL_Color &color = colors.size() == 1 ? colors[0] : colors[index];
+        return {.r = color.r / 255.0f, .g = color.g / 255.0f, .b = color.b / 255.0f, .a = color.a / 255.0f};
+    }
+}
+
 //                          ---- Construction ----
 
 sdl3::Renderer::Renderer(sdl3::Window &window)
@@ -12,9 +33,26 @@ sdl3::Renderer::Renderer(sdl3::Window &window)
     m_initialized = true;
 }
 
+sdl3::Renderer::Renderer(int width, int height)
+    : m_surface{SDL_CreateSurface(width, height, SDL_PIXELFORMAT_ABGR8888), SDL_DestroySurface}
+    , m_width{width}
+    , m_height{height}
+{
+    if (!m_surface) { return; }
+
+    m_renderer = SDL_CreateSoftwareRenderer(m_surface.get());
+    if (!m_renderer) { return; }
+
+    m_initialized = true;
+}
+
 sdl3::Renderer::~Renderer()
 {
     if (!m_initialized) { return; }
+
+    // Textures can't outlive the renderer that created them.
+    m_targetPool.clear();
+    m_target.reset();
     SDL_DestroyRenderer(m_renderer);
 }
 
@@ -33,24 +71,200 @@ bool sdl3::Renderer::set_logical_presentation(int width, int height)
     return SDL_SetRenderLogicalPresentation(m_renderer, width, height, SDL_LOGICAL_PRESENTATION_INTEGER_SCALE);
 }
 
-bool sdl3::Renderer::set_render_target(sdl3::SharedTexture &target) { return SDL_SetRenderTarget(m_renderer, *target); }
+bool sdl3::Renderer::set_vsync(int interval) { return SDL_SetRenderVSync(m_renderer, interval); }
+
+bool sdl3::Renderer::set_render_target(sdl3::SharedTexture &target)
+{
+    // Anything batched so far belongs to the old target. Nothing needs to be flushed if the target isn't changing.
+    if (!m_state.is_target(*target)) { Renderer::flush_batch(); }
+
+    m_target = target;
+    return m_state.set_target(m_renderer, *target);
+}
+
+sdl3::SharedTexture sdl3::Renderer::get_render_target() const noexcept { return m_target; }
 
 bool sdl3::Renderer::set_render_clip(int x, int y, int width, int height)
 {
     const SDL_Rect renderClip = {.x = x, .y = y, .w = width, .h = height};
-    return SDL_SetRenderClipRect(m_renderer, &renderClip);
+    if (!m_state.is_clip(&renderClip)) { Renderer::flush_batch(); }
+
+    return m_state.set_clip(m_renderer, &renderClip);
 }
 
-bool sdl3::Renderer::frame_begin(SDL_Color clear)
+bool sdl3::Renderer::set_draw_color(SDL_Color color) { return m_state.set_draw_color(m_renderer, color); }
+
+bool sdl3::Renderer::set_draw_blend_mode(SDL_BlendMode blendMode)
+{ return m_state.set_draw_blend_mode(m_renderer, blendMode); }
+
+void sdl3::Renderer::invalidate_state() noexcept { m_state.invalidate(); }
+
+bool sdl3::Renderer::clear(SDL_Color clear)
 {
-    const bool target = SDL_SetRenderTarget(m_renderer, nullptr);
-    const bool color  = target && SDL_SetRenderDrawColor(m_renderer, clear.r, clear.g, clear.b, clear.a);
+    // Clearing isn't batched, so anything queued has to go first.
+    Renderer::flush_batch();
 
+    const bool color = m_state.set_draw_color(m_renderer, clear);
     return color && SDL_RenderClear(m_renderer);
 }
 
-bool sdl3::Renderer::frame_end() { return SDL_RenderPresent(m_renderer); }
+bool sdl3::Renderer::fill_rects(std::span<const SDL_FRect> rects, std::span<const SDL_Color> colors)
+{
+    if (rects.empty()) { return true; }
+    if (!colors_match(rects.size(), colors.size())) { return false; }
+
+    for (size_t i = 0; i < rects.size(); i++)
+    {
+        const SDL_FRect &rect = rects[i];
+        const float right     = rect.x + rect.w;
+        const float bottom    = rect.y + rect.h;
+        Renderer::add_primitive_quad({{rect.x, rect.y}, {right, rect.y}, {right, bottom}, {rect.x, bottom}},
+                                     get_primitive_color(colors, i));
+    }
+
+    return Renderer::submit_primitives();
+}
+
+bool sdl3::Renderer::draw_lines(std::span<const SDL_FPoint> points, std::span<const SDL_Color> colors)
+{
+    if (points.empty()) { return true; }
+
+    const size_t segmentCount = points.size() / 2;
+    if (points.size() % 2 != 0 || !colors_match(segmentCount, colors.size())) { return false; }
+
+    for (size_t i = 0; i < segmentCount; i++)
+    {
+        const SDL_FPoint &start = points[i * 2];
+        const SDL_FPoint &end   = points[i * 2 + 1];
+        const SDL_FColor color  = get_primitive_color(colors, i);
+
+        // Segments are quads one pixel wide. Zero length ones are drawn as a single pixel.
+        const float deltaX = end.x - start.x;
+        const float deltaY = end.y - start.y;
+        const float length = std::sqrt(deltaX * deltaX + deltaY * deltaY);
+        if (length == 0.0f)
+        {
+            Renderer::add_primitive_quad({{start.x, start.y}, {start.x + 1.0f, start.y}, {start.x + 1.0f, start.y + 1.0f},
+                                          {start.x, start.y + 1.0f}},
+                                         color);
+            continue;
+        }
+
+        // Half a pixel out to each side, measured through the pixel centers.
+        const float normalX = -deltaY / length * 0.5f;
+        const float normalY = deltaX / length * 0.5f;
+        const float startX  = start.x + 0.5f;
+        const float startY  = start.y + 0.5f;
+        const float endX    = end.x + 0.5f;
+        const float endY    = end.y + 0.5f;
+        Renderer::add_primitive_quad({{startX + normalX, startY + normalY},
+                                      {endX + normalX, endY + normalY},
+                                      {endX - normalX, endY - normalY},
+                                      {startX - normalX, startY - normalY}},
+                                     color);
+    }
+
+    return Renderer::submit_primitives();
+}
+
+bool sdl3::Renderer::draw_points(std::span<const SDL_FPoint> points, std::span<const SDL_Color> colors)
+{
+    if (points.empty()) { return true; }
+    if (!colors_match(points.size(), colors.size())) { return false; }
+
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        const SDL_FPoint &point = points[i];
+        Renderer::add_primitive_quad({{point.x, point.y},
+                                      {point.x + 1.0f, point.y},
+                                      {point.x + 1.0f, point.y + 1.0f},
+                                      {point.x, point.y + 1.0f}},
+                                     get_primitive_color(colors, i));
+    }
+
+    return Renderer::submit_primitives();
+}
+
+bool sdl3::Renderer::frame_begin(SDL_Color clear)
+{
+    RENDER_STATS_FRAME_BEGIN();
+
+    // Textures loaded in the background are uploaded before anything is drawn.
+    sdl3::TextureLoader::upload_pending();
+
+    // This only reaches SDL if something else was left targeted.
+    m_target          = sdl3::Texture::NullTexture;
+    const bool target = m_state.set_target(m_renderer, nullptr);
+
+    return target && Renderer::clear(clear);
+}
+
+bool sdl3::Renderer::frame_end()
+{
+    // Textures changed without being drawn get their uploads out of the way now.
+    const bool uploads = sdl3::Texture::upload_all_changes();
+    const bool batch   = (!m_batch.is_active() || m_batch.end()) && uploads;
+
+    // Presenting can wait on vsync, so it isn't part of the frame's time.
+    RENDER_STATS_FRAME_END();
+
+    return SDL_RenderPresent(m_renderer) && batch;
+}
+
+void sdl3::Renderer::begin_batch(sdl3::SpriteBatch::SortMode sortMode) { m_batch.begin(m_renderer, sortMode); }
+
+bool sdl3::Renderer::end_batch() { return m_batch.end(); }
+
+bool sdl3::Renderer::flush_batch() { return m_batch.flush(); }
+
+sdl3::Surface sdl3::Renderer::read_pixels(const SDL_Rect *rect)
+{
+    // Whatever's still batched hasn't been drawn yet.
+    Renderer::flush_batch();
+
+    return sdl3::Surface{SDL_RenderReadPixels(m_renderer, rect), SDL_DestroySurface};
+}
+
+bool sdl3::Renderer::is_headless() const noexcept { return m_surface != nullptr; }
+
+sdl3::SpriteBatch &sdl3::Renderer::get_sprite_batch() noexcept { return m_batch; }
+
+sdl3::TargetPool &sdl3::Renderer::get_target_pool() noexcept { return m_targetPool; }
 
 sdl3::Renderer::operator SDL_Renderer *() const noexcept { return m_renderer; }
 
-//                      ---- Private Functions ----
\ No newline at end of file
+//                      ---- Private Functions ----
+
+void sdl3::Renderer::add_primitive_quad(const SDL_FPoint (&corners)[4], SDL_FColor color)
+{
+    // Quad index pattern.
+    static constexpr int QUAD_INDICES[] = {0, 1, 2, 2, 3, 0};
+
+    const int baseVertex = static_cast<int>(m_primitiveVertices.size());
+    for (const SDL_FPoint &corner : corners)
+    {
+        m_primitiveVertices.push_back({.position = corner, .color = color, .tex_coord = {0.0f, 0.0f}});
+    }
+    for (const int index : QUAD_INDICES) { m_primitiveIndices.push_back(baseVertex + index); }
+}
+
+bool sdl3::Renderer::submit_primitives()
+{
+    bool success = true;
+    if (m_batch.is_active()) { m_batch.add_geometry(nullptr, m_primitiveVertices, m_primitiveIndices, {1, 1, 1, 1}); }
+    else
+    {
+        RENDER_STATS_DRAW(nullptr, m_primitiveVertices.size());
+        success = SDL_RenderGeometry(m_renderer,
+                                     nullptr,
+                                     m_primitiveVertices.data(),
+                                     static_cast<int>(m_primitiveVertices.size()),
+                                     m_primitiveIndices.data(),
+                                     static_cast<int>(m_primitiveIndices.size()));
+    }
+
+    m_primitiveVertices.clear();
+    m_primitiveIndices.clear();
+
+    return success;
+}
\ No newline at end of file
@@ -7,12 +7,12 @@
 //                      ---- Construction ----
 
 sdl3::SDL3::SDL3()
-{
-    // Flags to init with.
-    static constexpr SDL_InitFlags INIT_FLAGS = SDL_INIT_AUDIO | SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_GAMEPAD;
+    : SDL3(SDL_INIT_AUDIO | SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_GAMEPAD) {}
 
+sdl3::SDL3::SDL3(SDL_InitFlags initFlags)
+{
     // Return if init fails.
-    if (!SDL_Init(INIT_FLAGS)) { return; }
+    if (!SDL_Init(initFlags)) { return; }
 
     // We're good?
     m_initialized = true;
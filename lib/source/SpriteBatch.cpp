@@ -0,0 +1,147 @@
+#include "SpriteBatch.hpp"
+
+#include "RenderStats.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+//                      ---- Construction ----
+
+//                      ---- Public Functions ----
+
+void sdl3::SpriteBatch::begin(SDL_Renderer *renderer, SpriteBatch::SortMode sortMode)
+{
+    // Anything left over from a batch that was never ended gets submitted first.
+    if (m_active) { SpriteBatch::flush(); }
+
+    m_renderer = renderer;
+    m_sortMode = sortMode;
+    m_active   = true;
+}
+
+bool sdl3::SpriteBatch::end()
+{
+    const bool flushed = SpriteBatch::flush();
+    m_active           = false;
+
+    return flushed;
+}
+
+bool sdl3::SpriteBatch::flush()
+{
+    if (m_commands.empty()) { return true; }
+
+    // Grouping by texture only reorders across textures. Submissions sharing one keep their order.
+    if (m_sortMode == SpriteBatch::SortMode::Texture)
+    {
+        auto compare_texture = [](const Command &a, const Command &b) { return a.texture < b.texture; };
+        std::stable_sort(m_commands.begin(), m_commands.end(), compare_texture);
+    }
+
+    bool success = true;
+    for (size_t i = 0; i < m_commands.size();)
+    {
+        // Gather every command in a row that uses the same texture into one draw call.
+        SDL_Texture *texture = m_commands[i].texture;
+        m_drawVertices.clear();
+        m_drawIndices.clear();
+
+        for (; i < m_commands.size() && m_commands[i].texture == texture; i++)
+        {
+            const Command &command = m_commands[i];
+            const int baseVertex   = static_cast<int>(m_drawVertices.size());
+
+            const auto vertexBegin = m_vertices.begin() + command.firstVertex;
+            m_drawVertices.insert(m_drawVertices.end(), vertexBegin, vertexBegin + command.vertexCount);
+
+            const auto indexBegin = m_indices.begin() + command.firstIndex;
+            const auto indexEnd   = indexBegin + command.indexCount;
+            std::transform(indexBegin,
+                           indexEnd,
+                           std::back_inserter(m_drawIndices),
+                           [baseVertex](int index) { return index + baseVertex; });
+        }
+
+        success = SDL_RenderGeometry(m_renderer,
+                                     texture,
+                                     m_drawVertices.data(),
+                                     static_cast<int>(m_drawVertices.size()),
+                                     m_drawIndices.data(),
+                                     static_cast<int>(m_drawIndices.size())) &&
+                  success;
+
+        RENDER_STATS_DRAW(texture, m_drawVertices.size());
+    }
+
+    m_vertices.clear();
+    m_indices.clear();
+    m_commands.clear();
+
+    return success;
+}
+
+bool sdl3::SpriteBatch::is_active() const noexcept { return m_active; }
+
+void sdl3::SpriteBatch::add_quad(SDL_Texture *texture,
+                                 float textureWidth,
+                                 float textureHeight,
+                                 const SDL_FRect &sourceRect,
+                                 const SDL_FRect &destRect,
+                                 SDL_FColor color)
+{
+    // Quad index pattern.
+    static constexpr int QUAD_INDICES[] = {0, 1, 2, 2, 3, 0};
+
+    // Texture coordinates.
+    const float u0 = sourceRect.x / textureWidth;
+    const float v0 = sourceRect.y / textureHeight;
+    const float u1 = (sourceRect.x + sourceRect.w) / textureWidth;
+    const float v1 = (sourceRect.y + sourceRect.h) / textureHeight;
+
+    // Corners.
+    const float right  = destRect.x + destRect.w;
+    const float bottom = destRect.y + destRect.h;
+
+    const SDL_Vertex vertices[] = {{.position = {destRect.x, destRect.y}, .color = color, .tex_coord = {u0, v0}},
+                                   {.position = {right, destRect.y}, .color = color, .tex_coord = {u1, v0}},
+                                   {.position = {right, bottom}, .color = color, .tex_coord = {u1, v1}},
+                                   {.position = {destRect.x, bottom}, .color = color, .tex_coord = {u0, v1}}};
+
+    SpriteBatch::add_geometry(texture, vertices, QUAD_INDICES, {1.0f, 1.0f, 1.0f, 1.0f});
+}
+
+void sdl3::SpriteBatch::add_geometry(SDL_Texture *texture,
+                                     std::span<const SDL_Vertex> vertices,
+                                     std::span<const int> indices,
+                                     SDL_FColor colorMod)
+{
+    // Neighboring submissions with the same texture just extend the previous command.
+    const bool extendLast = !m_commands.empty() && m_commands.back().texture == texture;
+    if (!extendLast)
+    {
+        m_commands.push_back({.texture = texture, .firstVertex = m_vertices.size(), .firstIndex = m_indices.size()});
+    }
+
+    Command &command     = m_commands.back();
+    const int baseVertex = static_cast<int>(command.vertexCount);
+
+    // Vertices. The color mod is folded into the vertex color since the texture's own mod is shared by every submission.
+    const bool modColor = colorMod.r != 1.0f || colorMod.g != 1.0f || colorMod.b != 1.0f || colorMod.a != 1.0f;
+    for (SDL_Vertex vertex : vertices)
+    {
+        if (modColor)
+        {
+            vertex.color.r *= colorMod.r;
+            vertex.color.g *= colorMod.g;
+            vertex.color.b *= colorMod.b;
+            vertex.color.a *= colorMod.a;
+        }
+        m_vertices.push_back(vertex);
+    }
+
+    // Indices are stored relative to the start of the command.
+    for (const int index : indices) { m_indices.push_back(index + baseVertex); }
+
+    command.vertexCount += vertices.size();
+    command.indexCount += indices.size();
+}
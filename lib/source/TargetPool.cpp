@@ -0,0 +1,55 @@
+#include "TargetPool.hpp"
+
+#include <algorithm>
+#include <bit>
+
+//                      ---- Construction ----
+
+//                      ---- Public Functions ----
+
+sdl3::SharedTexture sdl3::TargetPool::acquire(int width, int height)
+{
+    const int classWidth  = TargetPool::get_class_size(width);
+    const int classHeight = TargetPool::get_class_size(height);
+
+    // Reuse an idle target of the same class if there is one.
+    std::vector<sdl3::SharedTexture> &idleTargets = m_idleTargets[TargetPool::get_class_key(classWidth, classHeight)];
+    if (!idleTargets.empty())
+    {
+        sdl3::SharedTexture target = std::move(idleTargets.back());
+        idleTargets.pop_back();
+        return target;
+    }
+
+    sdl3::SharedTexture target = std::make_shared<sdl3::Texture>(classWidth, classHeight, SDL_TEXTUREACCESS_TARGET);
+    if (!target->is_initialized()) { return nullptr; }
+
+    return target;
+}
+
+void sdl3::TargetPool::release(sdl3::SharedTexture &target)
+{
+    if (!target) { return; }
+
+    // Targets are always created at class sizes, so the size is the class.
+    std::vector<sdl3::SharedTexture> &idleTargets =
+        m_idleTargets[TargetPool::get_class_key(target->get_width(), target->get_height())];
+    if (idleTargets.size() < MAX_IDLE_PER_CLASS) { idleTargets.push_back(std::move(target)); }
+
+    // If the class was full, this drops the last reference. The texture flushes anything batched with it first.
+    target.reset();
+}
+
+void sdl3::TargetPool::clear() { m_idleTargets.clear(); }
+
+//                      ---- Private Functions ----
+
+int sdl3::TargetPool::get_class_size(int size) noexcept
+{
+    return static_cast<int>(std::bit_ceil(static_cast<unsigned int>(std::max(size, MIN_CLASS_SIZE))));
+}
+
+uint64_t sdl3::TargetPool::get_class_key(int classWidth, int classHeight) noexcept
+{
+    return (static_cast<uint64_t>(classWidth) << 32) | static_cast<uint32_t>(classHeight);
+}
@@ -0,0 +1,104 @@
+#include "TextLabel.hpp"
+
+#include "Renderer.hpp"
+
+//                      ---- Construction ----
+
+sdl3::TextLabel::TextLabel(sdl3::SharedFont font, std::string_view text, SDL_Color color)
+    : m_font{std::move(font)}
+    , m_text{text}
+    , m_color{color}
+{
+    TextLabel::update_size();
+}
+
+sdl3::TextLabel::~TextLabel()
+{
+    if (m_target && sm_renderer) { sm_renderer->get_target_pool().release(m_target); }
+}
+
+//                      ---- Public Functions ----
+
+void sdl3::TextLabel::initialize(sdl3::Renderer &renderer) { sm_renderer = &renderer; }
+
+void sdl3::TextLabel::set_text(std::string_view text)
+{
+    if (text == m_text) { return; }
+
+    m_text.assign(text);
+    m_dirty = true;
+    TextLabel::update_size();
+}
+
+void sdl3::TextLabel::set_color(SDL_Color color)
+{
+    if (color.r == m_color.r && color.g == m_color.g && color.b == m_color.b && color.a == m_color.a) { return; }
+
+    m_color = color;
+    m_dirty = true;
+}
+
+void sdl3::TextLabel::set_font(sdl3::SharedFont font)
+{
+    if (font == m_font) { return; }
+
+    m_font  = std::move(font);
+    m_dirty = true;
+    TextLabel::update_size();
+}
+
+void sdl3::TextLabel::invalidate() noexcept { m_dirty = true; }
+
+std::string_view sdl3::TextLabel::get_text() const noexcept { return m_text; }
+
+int sdl3::TextLabel::get_width() const noexcept { return m_width; }
+
+int sdl3::TextLabel::get_height() const noexcept { return m_height; }
+
+bool sdl3::TextLabel::render(int x, int y)
+{
+    if (m_dirty && !TextLabel::bake()) { return false; }
+
+    // Nothing to draw.
+    if (!m_target) { return true; }
+
+    return m_target->render_part(x - PADDING, y - PADDING, 0, 0, m_width + (PADDING * 2), m_height + (PADDING * 2));
+}
+
+//                      ---- Private Functions ----
+
+void sdl3::TextLabel::update_size()
+{
+    const sdl3::Font::TextMetrics metrics = m_font ? m_font->measure_text(m_text) : sdl3::Font::TextMetrics{};
+
+    m_width  = metrics.width;
+    m_height = metrics.height;
+}
+
+bool sdl3::TextLabel::bake()
+{
+    if (!sm_renderer || !m_font) { return false; }
+
+    // The pool hands the same target back if the size class didn't change.
+    sdl3::TargetPool &targetPool = sm_renderer->get_target_pool();
+    targetPool.release(m_target);
+
+    // Empty labels don't need a target at all.
+    m_dirty = false;
+    if (m_width == 0 || m_height == 0) { return true; }
+
+    m_target = targetPool.acquire(m_width + (PADDING * 2), m_height + (PADDING * 2));
+    if (!m_target) { return false; }
+
+    // Render to the target and put the old one back. Switching targets flushes the text out of the sprite batch.
+    sdl3::SharedTexture previousTarget = sm_renderer->get_render_target();
+    const bool targetSet               = sm_renderer->set_render_target(m_target);
+    const bool cleared                 = targetSet && sm_renderer->clear({0x00, 0x00, 0x00, 0x00});
+    if (cleared) { m_font->render_text(PADDING, PADDING, m_color, m_text); }
+    sm_renderer->set_render_target(previousTarget);
+
+    // Blending onto a transparent target leaves the color multiplied by alpha already.
+    m_target->set_blend_mode(SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+
+    return cleared;
+}
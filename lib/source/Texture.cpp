@@ -1,8 +1,59 @@
 #include "Texture.hpp"
 
+#include "PixelOps.hpp"
+#include "RenderStats.hpp"
 #include "Renderer.hpp"
 
 #include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <cstring>
+#include <optional>
+
+namespace
+{
+    /// @brief Returns the smallest rect containing both of the rects passed.
+    SDL_Rect bounding_rect(const SDL_Rect &a, const SDL_Rect &b) noexcept
+    {
+        const int left   = std::min(a.x, b.x);
+        const int top    = std::min(a.y, b.y);
+        const int right  = std::max(a.x + a.w, b.x + b.w);
+        const int bottom = std::max(a.y + a.h, b.y + b.h);
+
+        return {.x = left, .y = top, .w = right - left, .h = bottom - top};
+    }
+
+    /// @brief Returns whether or not the bounding rect of two touching rects covers nothing but the rects themselves.
+    bool bounds_covered(const SDL_Rect &a, const SDL_Rect &b) noexcept
+    {
+        auto contains = [](const SDL_Rect &outer, const SDL_Rect &inner)
+        {
+            const bool insideX = inner.x >= outer.x && inner.x + inner.w <= outer.x + outer.w;
+            const bool insideY = inner.y >= outer.y && inner.y + inner.h <= outer.y + outer.h;
+            return insideX && insideY;
+        };
+
+        // Touching rects spanning the same columns or rows join into a rect of their own.
+        const bool sameColumns = a.x == b.x && a.w == b.w;
+        const bool sameRows    = a.y == b.y && a.h == b.h;
+
+        return sameColumns || sameRows || contains(a, b) || contains(b, a);
+    }
+
+    /// @brief Returns the channel layout of the format passed. std::nullopt if it isn't 32 bit with 8 bits per channel.
+    std::optional<sdl3::pixel_ops::PixelLayout> get_pixel_layout(SDL_PixelFormat format) noexcept
+    {
+        const SDL_PixelFormatDetails *details = SDL_GetPixelFormatDetails(format);
+        if (!details || details->bits_per_pixel != 32) { return std::nullopt; }
+
+        const bool eightBit = details->Rbits == 8 && details->Gbits == 8 && details->Bbits == 8 && details->Abits == 8;
+        if (!eightBit) { return std::nullopt; }
+
+        return sdl3::pixel_ops::PixelLayout{.redShift   = details->Rshift,
+                                            .greenShift = details->Gshift,
+                                            .blueShift  = details->Bshift,
+                                            .alphaShift = details->Ashift};
+    }
+}
 
 //                      ---- Construction ----
 
@@ -10,28 +61,25 @@ sdl3::Texture::Texture(std::string_view texturePath)
 {
     if (!sm_renderer) { return; }
 
-    // Load the texture with SDL_image.
-    m_texture = IMG_LoadTexture(sm_renderer, texturePath.data());
-    if (!m_texture) { return; }
-
-    // Get the width and height.
-    const bool dimensions = SDL_GetTextureSize(m_texture, &m_width, &m_height);
-    if (!dimensions) { return; }
+    // The image is decoded to a surface first so it can be converted and possibly atlased.
+    sdl3::Surface surface = sdl3::create_surface_from_image(texturePath);
+    if (!surface) { return; }
 
-    // Good to go?
-    m_initialized = true;
+    m_initialized = Texture::create_from_surface(surface.get());
 }
 
 sdl3::Texture::Texture(sdl3::Surface &surface)
-    : m_width{static_cast<float>(surface->w)}
-    , m_height{static_cast<float>(surface->h)}
 {
     if (!sm_renderer) { return; }
 
-    m_texture = SDL_CreateTextureFromSurface(sm_renderer, surface.get());
-    if (!m_texture) { return; }
+    m_initialized = Texture::create_from_surface(surface.get());
+}
 
-    m_initialized = true;
+sdl3::Texture::Texture(sdl3::Surface &surface, bool premultiplied)
+{
+    if (!sm_renderer || !surface || surface->format != sm_nativeFormat) { return; }
+
+    m_initialized = Texture::create_from_pixels(surface->pixels, surface->pitch, surface->w, surface->h, premultiplied);
 }
 
 sdl3::Texture::Texture(std::span<const uint8_t> data)
@@ -40,19 +88,22 @@ sdl3::Texture::Texture(std::span<const uint8_t> data)
 
     // SDL IO.
     SDL_IOStream *io = SDL_IOFromConstMem(data.data(), data.size());
-    m_texture        = IMG_LoadTexture_IO(sm_renderer, io, true);
-    if (!m_texture) { return; }
+    sdl3::Surface surface{IMG_Load_IO(io, true), SDL_DestroySurface};
+    if (!surface) { return; }
 
-    m_initialized = true;
+    m_initialized = Texture::create_from_surface(surface.get());
 }
 
 sdl3::Texture::Texture(int width, int height, SDL_TextureAccess accessFlags)
+    : Texture(width, height, sm_nativeFormat, accessFlags) {}
+
+sdl3::Texture::Texture(int width, int height, SDL_PixelFormat format, SDL_TextureAccess accessFlags)
     : m_width{static_cast<float>(width)}
     , m_height{static_cast<float>(height)}
 {
     if (!sm_renderer) { return; }
 
-    m_texture = SDL_CreateTexture(sm_renderer, SDL_PIXELFORMAT_ABGR8888, accessFlags, width, height);
+    m_texture = SDL_CreateTexture(sm_renderer, format, accessFlags, width, height);
     if (!m_texture) { return; }
 
     m_initialized = true;
@@ -60,23 +111,247 @@ sdl3::Texture::Texture(int width, int height, SDL_TextureAccess accessFlags)
 
 sdl3::Texture::~Texture()
 {
-    if (m_texture) { SDL_DestroyTexture(m_texture); }
+    // Atlased textures don't own the page's texture. The sprite batch only holds the raw SDL texture, so anything still
+    // queued with it has to go out first.
+    if (m_texture && !m_atlasPage)
+    {
+        Texture::flush_batch();
+        SDL_DestroyTexture(m_texture);
+    }
+    if (m_palette) { SDL_DestroyPalette(m_palette); }
+
+    // Make sure the renderer doesn't try to upload this later.
+    if (!m_dirtyRects.empty()) { std::erase(sm_dirtyTextures, this); }
 }
 
 //                      ---- Public Functions ----
 
-void sdl3::Texture::initialize(sdl3::Renderer &renderer) { sm_renderer = static_cast<SDL_Renderer *>(renderer); }
+void sdl3::Texture::initialize(sdl3::Renderer &renderer)
+{
+    sm_renderer = static_cast<SDL_Renderer *>(renderer);
+    sm_batch    = &renderer.get_sprite_batch();
+
+    // The renderer lists its formats best first. The first one with 8 bits for every channel including alpha wins.
+    const SDL_PropertiesID properties = SDL_GetRendererProperties(sm_renderer);
+    const SDL_PixelFormat *formats    = static_cast<const SDL_PixelFormat *>(
+        SDL_GetPointerProperty(properties, SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER, nullptr));
+
+    sm_nativeFormat = SDL_PIXELFORMAT_ABGR8888;
+    for (; formats && *formats != SDL_PIXELFORMAT_UNKNOWN; formats++)
+    {
+        if (get_pixel_layout(*formats).has_value())
+        {
+            sm_nativeFormat = *formats;
+            break;
+        }
+    }
+}
+
+SDL_PixelFormat sdl3::Texture::get_native_format() noexcept { return sm_nativeFormat; }
+
+void sdl3::Texture::set_premultiply_alpha(bool premultiply) noexcept { sm_premultiplyAlpha = premultiply; }
+
+bool sdl3::Texture::get_premultiply_alpha() noexcept { return sm_premultiplyAlpha; }
+
+bool sdl3::Texture::prepare_surface(sdl3::Surface &surface, bool premultiply)
+{
+    if (!surface) { return false; }
+    if (surface->format == sm_nativeFormat && !premultiply) { return true; }
+
+    // The worker converts into a surface of its own, so the shared convert buffer is never touched off the render thread.
+    sdl3::Surface prepared{SDL_CreateSurface(surface->w, surface->h, sm_nativeFormat), SDL_DestroySurface};
+    if (!prepared) { return false; }
+
+    const int destPitch = prepared->pitch / static_cast<int>(sizeof(uint32_t));
+    if (!Texture::convert_surface(surface.get(), static_cast<uint32_t *>(prepared->pixels), destPitch, premultiply))
+    {
+        return false;
+    }
+
+    surface = std::move(prepared);
+    return true;
+}
+
+void sdl3::Texture::set_atlas_threshold(int maxSize) noexcept { sm_atlasThreshold = maxSize; }
+
+bool sdl3::Texture::supports_format(SDL_PixelFormat format)
+{
+    if (!sm_renderer) { return false; }
+
+    // The renderer lists its formats in an array terminated by SDL_PIXELFORMAT_UNKNOWN.
+    const SDL_PropertiesID properties = SDL_GetRendererProperties(sm_renderer);
+    const SDL_PixelFormat *formats    = static_cast<const SDL_PixelFormat *>(
+        SDL_GetPointerProperty(properties, SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER, nullptr));
+    if (!formats) { return false; }
+
+    for (; *formats != SDL_PIXELFORMAT_UNKNOWN; formats++)
+    {
+        if (*formats == format) { return true; }
+    }
+
+    return false;
+}
 
 int sdl3::Texture::get_width() const noexcept { return m_width; }
 
 int sdl3::Texture::get_height() const noexcept { return m_height; }
 
-bool sdl3::Texture::set_alpha_mod(uint8_t alpha) { return SDL_SetTextureAlphaMod(m_texture, alpha); }
+bool sdl3::Texture::is_premultiplied() const noexcept { return m_premultiplied; }
+
+uint32_t sdl3::Texture::get_id() const noexcept { return m_atlasPage ? m_atlasPage->m_id : m_id; }
+
+bool sdl3::Texture::set_alpha_mod(uint8_t alpha)
+{
+    // The mods are only pushed to SDL when the texture is actually rendered.
+    m_colorMod.a = alpha;
+    return m_initialized;
+}
 
 bool sdl3::Texture::set_color_mod(SDL_Color colorMod)
-{ return SDL_SetTextureColorMod(m_texture, colorMod.r, colorMod.g, colorMod.b); }
+{
+    m_colorMod = {colorMod.r, colorMod.g, colorMod.b, m_colorMod.a};
+    return m_initialized;
+}
+
+bool sdl3::Texture::set_scale_mode(SDL_ScaleMode scaleMode)
+{
+    // Atlased textures share these with their page, so the page keeps track of them.
+    sdl3::Texture &owner = Texture::get_owner();
+    if (owner.m_scaleMode == scaleMode)
+    {
+        RENDER_STATS_ADD(elidedCalls);
+        return true;
+    }
+
+    const bool scaleSet = SDL_SetTextureScaleMode(m_texture, scaleMode);
+    owner.m_scaleMode   = scaleSet ? std::optional{scaleMode} : std::nullopt;
+
+    return scaleSet;
+}
+
+bool sdl3::Texture::set_blend_mode(SDL_BlendMode blendMode)
+{
+    sdl3::Texture &owner = Texture::get_owner();
+    if (owner.m_blendMode == blendMode)
+    {
+        RENDER_STATS_ADD(elidedCalls);
+        return true;
+    }
+
+    const bool blendSet = SDL_SetTextureBlendMode(m_texture, blendMode);
+    owner.m_blendMode   = blendSet ? std::optional{blendMode} : std::nullopt;
+
+    return blendSet;
+}
+
+bool sdl3::Texture::set_palette(std::span<const SDL_Color> colors)
+{
+#if SDL_VERSION_ATLEAST(3, 4, 0)
+    if (!m_texture) { return false; }
+
+    // Create the palette the first time around.
+    if (!m_palette) { m_palette = SDL_CreatePalette(static_cast<int>(colors.size())); }
+    if (!m_palette) { return false; }
+
+    const bool colorsSet = SDL_SetPaletteColors(m_palette, colors.data(), 0, static_cast<int>(colors.size()));
+    return colorsSet && SDL_SetTexturePalette(m_texture, m_palette);
+#else
+    return false;
+#endif
+}
+
+bool sdl3::Texture::update(const SDL_Rect *rect, const void *pixels, int pitch)
+{
+    // Keep the staging buffer in step, so merged uploads from it later don't put back what was there before.
+    const std::optional<SDL_Rect> area = Texture::clip_to_texture(rect);
+    if (!m_staging.empty() && area.has_value())
+    {
+        const size_t bytesPerPixel = SDL_BYTESPERPIXEL(m_texture->format);
+        const size_t rowLength     = area->w * bytesPerPixel;
+        const int skipX            = rect ? area->x - rect->x : 0;
+        const int skipY            = rect ? area->y - rect->y : 0;
+        const uint8_t *source      = static_cast<const uint8_t *>(pixels) + skipY * pitch + skipX * bytesPerPixel;
+        uint8_t *dest              = m_staging.data() + area->y * m_stagingPitch + area->x * bytesPerPixel;
+        for (int y = 0; y < area->h; y++) { std::memcpy(dest + y * m_stagingPitch, source + y * pitch, rowLength); }
+
+        Texture::mark_written(*area);
+    }
+
+    return Texture::upload_rect(rect, pixels, pitch);
+}
+
+sdl3::LockedPixels sdl3::Texture::lock(const SDL_Rect *rect)
+{
+    const std::optional<SDL_Rect> area = Texture::clip_to_texture(rect);
+    if (!area.has_value() || !Texture::prepare_staging()) { return {}; }
+
+    Texture::mark_written(*area);
+    Texture::mark_dirty(*area);
+
+    // The view runs from the area's first pixel to the end of its last row.
+    const size_t bytesPerPixel = SDL_BYTESPERPIXEL(m_texture->format);
+    const size_t offset        = area->y * m_stagingPitch + area->x * bytesPerPixel;
+    const size_t length        = (area->h - 1) * m_stagingPitch + area->w * bytesPerPixel;
+
+    return {.pixels = std::span<uint8_t>{m_staging}.subspan(offset, length), .pitch = m_stagingPitch};
+}
+
+bool sdl3::Texture::update(const SDL_Rect &rect, std::span<const uint8_t> pixels)
+{
+    // Partially clipped updates would need the caller's rows skipped, so only rects fully inside are accepted.
+    const std::optional<SDL_Rect> area = Texture::clip_to_texture(&rect);
+    const bool inside = area.has_value() && area->x == rect.x && area->y == rect.y && area->w == rect.w && area->h == rect.h;
+    if (!inside || !Texture::prepare_staging()) { return false; }
+
+    const size_t rowLength = rect.w * SDL_BYTESPERPIXEL(m_texture->format);
+    if (pixels.size() < rowLength * rect.h) { return false; }
+
+    const sdl3::LockedPixels locked = Texture::lock(&rect);
+    for (int y = 0; y < rect.h; y++)
+    {
+        std::memcpy(locked.pixels.data() + y * locked.pitch, pixels.data() + y * rowLength, rowLength);
+    }
+
+    return true;
+}
+
+bool sdl3::Texture::upload_changes()
+{
+    if (m_dirtyRects.empty()) { return true; }
+
+    // Anything already batched with this texture was meant to use the old pixels.
+    Texture::flush_batch();
+
+    const size_t bytesPerPixel = SDL_BYTESPERPIXEL(m_texture->format);
 
-bool sdl3::Texture::set_scale_mode(SDL_ScaleMode scaleMode) { return SDL_SetTextureScaleMode(m_texture, scaleMode); }
+    bool success = true;
+    for (const SDL_Rect &rect : m_dirtyRects)
+    {
+        const uint8_t *pixels = m_staging.data() + rect.y * m_stagingPitch + rect.x * bytesPerPixel;
+        success               = Texture::upload_rect(&rect, pixels, m_stagingPitch) && success;
+    }
+
+    m_dirtyRects.clear();
+    std::erase(sm_dirtyTextures, this);
+
+    return success;
+}
+
+bool sdl3::Texture::upload_all_changes()
+{
+    // Every upload removes its texture from the list.
+    bool success = true;
+    while (!sm_dirtyTextures.empty()) { success = sm_dirtyTextures.back()->upload_changes() && success; }
+
+    return success;
+}
+
+bool sdl3::Texture::flush_batch()
+{
+    if (!sm_batch || !sm_batch->is_active()) { return true; }
+
+    return sm_batch->flush();
+}
 
 bool sdl3::Texture::render(int x, int y)
 {
@@ -87,7 +362,7 @@ bool sdl3::Texture::render(int x, int y)
     const SDL_FRect destRect   = {.x = static_cast<float>(x), .y = static_cast<float>(y), .w = m_width, .h = m_height};
 
     // Just return this. It's easier.
-    return SDL_RenderTexture(sm_renderer, m_texture, &sourceRect, &destRect);
+    return Texture::submit(sourceRect, destRect);
 }
 
 bool sdl3::Texture::render_stretched(int x, int y, int width, int height)
@@ -101,7 +376,7 @@ bool sdl3::Texture::render_stretched(int x, int y, int width, int height)
                                   .w = static_cast<float>(width),
                                   .h = static_cast<float>(height)};
 
-    return SDL_RenderTexture(sm_renderer, m_texture, &sourceRect, &destRect);
+    return Texture::submit(sourceRect, destRect);
 }
 
 bool sdl3::Texture::render_part(int x, int y, int sourceX, int sourceY, int sourceWidth, int sourceHeight)
@@ -118,7 +393,7 @@ bool sdl3::Texture::render_part(int x, int y, int sourceX, int sourceY, int sour
                                   .w = static_cast<float>(sourceWidth),
                                   .h = static_cast<float>(sourceHeight)};
 
-    return SDL_RenderTexture(sm_renderer, m_texture, &sourceRect, &destRect);
+    return Texture::submit(sourceRect, destRect);
 }
 
 bool sdl3::Texture::render_part_stretched(int x,
@@ -141,9 +416,320 @@ bool sdl3::Texture::render_part_stretched(int x,
                                   .w = static_cast<float>(width),
                                   .h = static_cast<float>(height)};
 
-    return SDL_RenderTexture(sm_renderer, m_texture, &sourceRect, &destRect);
+    return Texture::submit(sourceRect, destRect);
+}
+
+bool sdl3::Texture::render_geometry(std::span<const SDL_Vertex> vertices, std::span<const int> indices)
+{
+    if (!m_initialized) { return false; }
+
+    // Pending changes have to be on the GPU before the texture is drawn.
+    if (!m_dirtyRects.empty()) { Texture::upload_changes(); }
+
+    // Atlased textures need their texture coordinates moved onto the page.
+    sdl3::Texture &owner = Texture::get_owner();
+    if (m_atlasPage)
+    {
+        sm_atlasVertices.assign(vertices.begin(), vertices.end());
+        for (SDL_Vertex &vertex : sm_atlasVertices)
+        {
+            vertex.tex_coord.x = (m_atlasX + vertex.tex_coord.x * m_width) / owner.m_width;
+            vertex.tex_coord.y = (m_atlasY + vertex.tex_coord.y * m_height) / owner.m_height;
+        }
+        vertices = sm_atlasVertices;
+    }
+
+    // Batched geometry carries the mod in its vertex colors.
+    if (sm_batch && sm_batch->is_active())
+    {
+        owner.apply_color_mod({0xFF, 0xFF, 0xFF, 0xFF});
+        sm_batch->add_geometry(m_texture, vertices, indices, Texture::get_vertex_color());
+        return true;
+    }
+
+    owner.apply_color_mod(Texture::get_render_color_mod());
+    RENDER_STATS_DRAW(m_texture, vertices.size());
+    return SDL_RenderGeometry(sm_renderer,
+                              m_texture,
+                              vertices.data(),
+                              static_cast<int>(vertices.size()),
+                              indices.data(),
+                              static_cast<int>(indices.size()));
 }
 
 sdl3::Texture::operator SDL_Texture *() const noexcept { return m_texture; }
 
-//                      ---- Private Functions ----
\ No newline at end of file
+//                      ---- Private Functions ----
+
+SDL_Color sdl3::Texture::get_render_color_mod() const noexcept
+{
+    if (!m_premultiplied) { return m_colorMod; }
+
+    // Premultiplied pixels fade by scaling everything, not just alpha.
+    auto scale = [this](uint8_t channel) { return static_cast<uint8_t>((channel * m_colorMod.a + 127) / 255); };
+    return {scale(m_colorMod.r), scale(m_colorMod.g), scale(m_colorMod.b), m_colorMod.a};
+}
+
+SDL_FColor sdl3::Texture::get_vertex_color() const noexcept
+{
+    const SDL_Color colorMod = Texture::get_render_color_mod();
+    return {.r = colorMod.r / 255.0f, .g = colorMod.g / 255.0f, .b = colorMod.b / 255.0f, .a = colorMod.a / 255.0f};
+}
+
+bool sdl3::Texture::apply_color_mod(SDL_Color colorMod)
+{
+    // Skip the calls if SDL already has these.
+    const bool colorChanged = colorMod.r != m_appliedColorMod.r || colorMod.g != m_appliedColorMod.g ||
+                              colorMod.b != m_appliedColorMod.b;
+    const bool alphaChanged = colorMod.a != m_appliedColorMod.a;
+
+    const bool color = !colorChanged || SDL_SetTextureColorMod(m_texture, colorMod.r, colorMod.g, colorMod.b);
+    const bool alpha = !alphaChanged || SDL_SetTextureAlphaMod(m_texture, colorMod.a);
+    if (colorChanged) { RENDER_STATS_ADD(modChanges); }
+    else
+    {
+        RENDER_STATS_ADD(elidedCalls);
+    }
+
+    if (alphaChanged) { RENDER_STATS_ADD(modChanges); }
+    else
+    {
+        RENDER_STATS_ADD(elidedCalls);
+    }
+    if (color && alpha) { m_appliedColorMod = colorMod; }
+
+    return color && alpha;
+}
+
+bool sdl3::Texture::submit(const SDL_FRect &sourceRect, const SDL_FRect &destRect)
+{
+    // Pending changes have to be on the GPU before the texture is drawn.
+    if (!m_dirtyRects.empty()) { Texture::upload_changes(); }
+
+    // Atlased textures render from their spot on the page. The page holds the SDL_Texture's mods.
+    sdl3::Texture &owner     = Texture::get_owner();
+    const SDL_FRect pageRect = {.x = sourceRect.x + m_atlasX,
+                                .y = sourceRect.y + m_atlasY,
+                                .w = sourceRect.w,
+                                .h = sourceRect.h};
+
+    // Queue it if there's a batch going. The texture's mod is shared by every submission, so it has to go in the vertices.
+    if (sm_batch && sm_batch->is_active())
+    {
+        owner.apply_color_mod({0xFF, 0xFF, 0xFF, 0xFF});
+        sm_batch->add_quad(m_texture, owner.m_width, owner.m_height, pageRect, destRect, Texture::get_vertex_color());
+        return true;
+    }
+
+    owner.apply_color_mod(Texture::get_render_color_mod());
+    RENDER_STATS_DRAW(m_texture, 4);
+    return SDL_RenderTexture(sm_renderer, m_texture, &pageRect, &destRect);
+}
+
+bool sdl3::Texture::create_from_surface(SDL_Surface *surface)
+{
+    // Everything is converted once here so uploads are straight copies and the renderer never has to convert.
+    int pitch{};
+    const void *pixels = Texture::prepare_pixels(surface, pitch);
+    if (!pixels) { return false; }
+
+    return Texture::create_from_pixels(pixels, pitch, surface->w, surface->h, sm_premultiplyAlpha);
+}
+
+bool sdl3::Texture::create_from_pixels(const void *pixels, int pitch, int width, int height, bool premultiplied)
+{
+    // Small images are packed into the atlas if it's enabled.
+    const bool fits = width <= sm_atlasThreshold && height <= sm_atlasThreshold;
+    if (sm_atlasThreshold > 0 && fits && Texture::pack_into_atlas(pixels, pitch, width, height, premultiplied))
+    {
+        return true;
+    }
+
+    // Too big or the atlas couldn't take it, so it gets its own texture.
+    m_texture = SDL_CreateTexture(sm_renderer, sm_nativeFormat, SDL_TEXTUREACCESS_STATIC, width, height);
+    if (!m_texture) { return false; }
+
+    m_width         = static_cast<float>(width);
+    m_height        = static_cast<float>(height);
+    m_premultiplied = premultiplied;
+
+    const SDL_BlendMode blendMode = m_premultiplied ? SDL_BLENDMODE_BLEND_PREMULTIPLIED : SDL_BLENDMODE_BLEND;
+    return SDL_UpdateTexture(m_texture, nullptr, pixels, pitch) && Texture::set_blend_mode(blendMode);
+}
+
+bool sdl3::Texture::pack_into_atlas(const void *pixels, int pitch, int width, int height, bool premultiplied)
+{
+    // Forget pages nothing uses anymore.
+    std::erase_if(sm_atlasPages, [](const Texture::AtlasPage &page) { return page.texture.expired(); });
+
+    // Try the pages that already exist first. Premultiplied and straight images can't share a blend mode.
+    sdl3::SharedTexture page{};
+    std::optional<SDL_Rect> rect{};
+    for (Texture::AtlasPage &atlasPage : sm_atlasPages)
+    {
+        if (atlasPage.premultiplied != premultiplied) { continue; }
+
+        rect = atlasPage.packer.pack(width, height);
+        if (rect.has_value())
+        {
+            page = atlasPage.texture.lock();
+            break;
+        }
+    }
+
+    // Nothing had room, so start a new page.
+    if (!rect.has_value())
+    {
+        page = std::make_shared<sdl3::Texture>(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, sm_nativeFormat, SDL_TEXTUREACCESS_STATIC);
+        if (!page->is_initialized()) { return false; }
+
+        // Static textures start out undefined. The padding between images needs to be transparent.
+        const std::vector<uint32_t> blank(ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE);
+        const SDL_BlendMode blendMode = premultiplied ? SDL_BLENDMODE_BLEND_PREMULTIPLIED : SDL_BLENDMODE_BLEND;
+        const bool cleared            = page->update(nullptr, blank.data(), ATLAS_PAGE_SIZE * sizeof(uint32_t));
+        if (!cleared || !page->set_blend_mode(blendMode)) { return false; }
+
+        const sdl3::AtlasPacker packer{ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, ATLAS_PADDING};
+        Texture::AtlasPage &newPage = sm_atlasPages.emplace_back(page, packer, premultiplied);
+
+        rect = newPage.packer.pack(width, height);
+        if (!rect.has_value()) { return false; }
+    }
+
+    if (!page->update(&*rect, pixels, pitch)) { return false; }
+
+    m_texture       = page->m_texture;
+    m_atlasPage     = std::move(page);
+    m_atlasX        = static_cast<float>(rect->x);
+    m_atlasY        = static_cast<float>(rect->y);
+    m_width         = static_cast<float>(rect->w);
+    m_height        = static_cast<float>(rect->h);
+    m_premultiplied = premultiplied;
+
+    return true;
+}
+
+const void *sdl3::Texture::prepare_pixels(SDL_Surface *surface, int &pitch)
+{
+    // Nothing to do if the surface already matches.
+    if (surface->format == sm_nativeFormat && !sm_premultiplyAlpha)
+    {
+        pitch = surface->pitch;
+        return surface->pixels;
+    }
+
+    sm_convertBuffer.resize(static_cast<size_t>(surface->w) * surface->h);
+    if (!Texture::convert_surface(surface, sm_convertBuffer.data(), surface->w, sm_premultiplyAlpha)) { return nullptr; }
+
+    pitch = surface->w * static_cast<int>(sizeof(uint32_t));
+    return sm_convertBuffer.data();
+}
+
+bool sdl3::Texture::convert_surface(SDL_Surface *surface, uint32_t *dest, int destPitch, bool premultiply)
+{
+    // Anything that isn't 8 bits per channel gets converted by SDL first. The fast path handles the rest.
+    sdl3::Surface converted{nullptr, SDL_DestroySurface};
+    std::optional<sdl3::pixel_ops::PixelLayout> sourceLayout = get_pixel_layout(surface->format);
+    if (!sourceLayout.has_value())
+    {
+        converted.reset(SDL_ConvertSurface(surface, sm_nativeFormat));
+        if (!converted) { return false; }
+
+        surface      = converted.get();
+        sourceLayout = get_pixel_layout(sm_nativeFormat);
+    }
+
+    const std::optional<sdl3::pixel_ops::PixelLayout> destLayout = get_pixel_layout(sm_nativeFormat);
+    if (!sourceLayout.has_value() || !destLayout.has_value()) { return false; }
+
+    sdl3::pixel_ops::convert_pixels(static_cast<const uint32_t *>(surface->pixels),
+                                    surface->pitch / static_cast<int>(sizeof(uint32_t)),
+                                    dest,
+                                    destPitch,
+                                    surface->w,
+                                    surface->h,
+                                    *sourceLayout,
+                                    *destLayout,
+                                    premultiply);
+
+    return true;
+}
+
+bool sdl3::Texture::prepare_staging()
+{
+    if (!m_staging.empty()) { return true; }
+    if (!m_texture) { return false; }
+
+    m_stagingPitch = Texture::get_width() * SDL_BYTESPERPIXEL(m_texture->format);
+    m_staging.resize(static_cast<size_t>(m_stagingPitch) * Texture::get_height());
+
+    return !m_staging.empty();
+}
+
+std::optional<SDL_Rect> sdl3::Texture::clip_to_texture(const SDL_Rect *rect) const noexcept
+{
+    const SDL_Rect bounds = {.x = 0, .y = 0, .w = Texture::get_width(), .h = Texture::get_height()};
+    if (!rect) { return bounds; }
+
+    const int left   = std::max(rect->x, 0);
+    const int top    = std::max(rect->y, 0);
+    const int right  = std::min(rect->x + rect->w, bounds.w);
+    const int bottom = std::min(rect->y + rect->h, bounds.h);
+    if (right <= left || bottom <= top) { return std::nullopt; }
+
+    return SDL_Rect{.x = left, .y = top, .w = right - left, .h = bottom - top};
+}
+
+bool sdl3::Texture::upload_rect(const SDL_Rect *rect, const void *pixels, int pitch)
+{
+    if (!m_atlasPage) { return SDL_UpdateTexture(m_texture, rect, pixels, pitch); }
+
+    // Atlased textures can only touch their own part of the page.
+    SDL_Rect pageRect = rect ? *rect : SDL_Rect{.x = 0, .y = 0, .w = Texture::get_width(), .h = Texture::get_height()};
+    pageRect.x += static_cast<int>(m_atlasX);
+    pageRect.y += static_cast<int>(m_atlasY);
+
+    return SDL_UpdateTexture(m_texture, &pageRect, pixels, pitch);
+}
+
+void sdl3::Texture::mark_written(const SDL_Rect &rect) noexcept
+{
+    const bool wholeTexture = rect.x == 0 && rect.y == 0 && rect.w == Texture::get_width() && rect.h == Texture::get_height();
+    m_stagingComplete       = m_stagingComplete || wholeTexture;
+}
+
+void sdl3::Texture::mark_dirty(SDL_Rect rect)
+{
+    if (m_dirtyRects.empty()) { sm_dirtyTextures.push_back(this); }
+
+    // Anything touching the new area is folded into it. The union can reach rects the original didn't, so start over.
+    // Merged areas are uploaded whole, so until all of staging has been written, only merges that don't pull in pixels
+    // nobody wrote are made. The texture has its own contents there that the cleared staging buffer would overwrite.
+    for (size_t i = 0; i < m_dirtyRects.size();)
+    {
+        const SDL_Rect &dirty = m_dirtyRects[i];
+        const bool touchesX   = rect.x <= dirty.x + dirty.w && dirty.x <= rect.x + rect.w;
+        const bool touchesY   = rect.y <= dirty.y + dirty.h && dirty.y <= rect.y + rect.h;
+        if (!touchesX || !touchesY || (!m_stagingComplete && !bounds_covered(rect, dirty)))
+        {
+            ++i;
+            continue;
+        }
+
+        rect            = bounding_rect(rect, dirty);
+        m_dirtyRects[i] = m_dirtyRects.back();
+        m_dirtyRects.pop_back();
+        i = 0;
+    }
+    m_dirtyRects.push_back(rect);
+
+    // Lots of little uploads cost more than a few extra bytes in one big one.
+    if (m_stagingComplete && m_dirtyRects.size() > MAX_DIRTY_RECTS)
+    {
+        SDL_Rect bounds = m_dirtyRects.front();
+        for (const SDL_Rect &dirty : m_dirtyRects) { bounds = bounding_rect(bounds, dirty); }
+        m_dirtyRects.assign(1, bounds);
+    }
+}
+
+sdl3::Texture &sdl3::Texture::get_owner() noexcept { return m_atlasPage ? *m_atlasPage : *this; }
\ No newline at end of file
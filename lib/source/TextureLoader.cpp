@@ -0,0 +1,102 @@
+#include "TextureLoader.hpp"
+
+#include "ResourceManager.hpp"
+#include "ThreadPool.hpp"
+
+#include <SDL3_image/SDL_image.h>
+
+//                      ---- Construction ----
+
+sdl3::AsyncTexture::AsyncTexture(sdl3::SharedTexture texture)
+    : m_state{std::make_shared<AsyncTexture::LoadState>()}
+{
+    m_state->texture  = std::move(texture);
+    m_state->finished = true;
+}
+
+sdl3::AsyncTexture::AsyncTexture(std::shared_ptr<AsyncTexture::LoadState> state)
+    : m_state{std::move(state)} {}
+
+//                      ---- Public Functions ----
+
+bool sdl3::AsyncTexture::is_ready() const noexcept { return m_state && m_state->finished; }
+
+bool sdl3::AsyncTexture::has_failed() const noexcept { return AsyncTexture::is_ready() && !m_state->texture; }
+
+sdl3::SharedTexture sdl3::AsyncTexture::get() const noexcept
+{ return AsyncTexture::is_ready() ? m_state->texture : nullptr; }
+
+sdl3::AsyncTexture sdl3::TextureLoader::load(std::string_view name, std::string_view texturePath)
+{
+    // Somebody already asked for this one.
+    auto findLoad = sm_inFlight.find(std::string{name});
+    if (findLoad != sm_inFlight.end()) { return sdl3::AsyncTexture{findLoad->second}; }
+
+    SharedLoadState state = std::make_shared<AsyncTexture::LoadState>();
+    state->name           = name;
+    state->path           = texturePath;
+    sm_inFlight.emplace(state->name, state);
+
+    sdl3::ThreadPool::get_shared().submit([state]() { TextureLoader::decode(state); });
+
+    return sdl3::AsyncTexture{state};
+}
+
+size_t sdl3::TextureLoader::upload_pending()
+{
+    // Grab whatever the workers have finished since last time.
+    {
+        std::lock_guard decodedLock{sm_decodedMutex};
+        sm_uploads.insert(sm_uploads.end(), sm_decoded.begin(), sm_decoded.end());
+        sm_decoded.clear();
+    }
+
+    // Always get at least one through so a tiny budget can't stall loading completely.
+    const uint64_t start = SDL_GetTicksNS();
+    size_t finished{};
+    while (!sm_uploads.empty() && (finished == 0 || SDL_GetTicksNS() - start < sm_uploadBudget))
+    {
+        const SharedLoadState state = std::move(sm_uploads.front());
+        sm_uploads.pop_front();
+
+        TextureLoader::finish(*state);
+        ++finished;
+    }
+
+    return finished;
+}
+
+void sdl3::TextureLoader::set_upload_budget(double milliseconds) noexcept
+{ sm_uploadBudget = static_cast<uint64_t>(milliseconds * 1000000.0); }
+
+size_t sdl3::TextureLoader::get_pending_count() noexcept { return sm_inFlight.size(); }
+
+//                      ---- Private Functions ----
+
+void sdl3::TextureLoader::decode(const SharedLoadState &state)
+{
+    // Converting and premultiplying here means the render thread only has to upload.
+    sdl3::Surface surface = sdl3::create_surface_from_image(state->path);
+    state->premultiplied  = sdl3::Texture::get_premultiply_alpha();
+    if (!sdl3::Texture::prepare_surface(surface, state->premultiplied)) { surface.reset(); }
+    state->surface = std::move(surface);
+
+    // Failed loads are queued too so they still get finished on the render thread.
+    std::lock_guard decodedLock{sm_decodedMutex};
+    sm_decoded.push_back(state);
+}
+
+void sdl3::TextureLoader::finish(AsyncTexture::LoadState &state)
+{
+    if (state.surface)
+    {
+        sdl3::SharedTexture texture = std::make_shared<sdl3::Texture>(state.surface, state.premultiplied);
+
+        // If the same name was loaded the normal way in the meantime, that one wins.
+        if (texture->is_initialized()) { state.texture = sdl3::TextureManager::insert_resource(state.name, texture); }
+    }
+
+    state.surface.reset();
+    state.finished = true;
+    sm_inFlight.erase(state.name);
+}
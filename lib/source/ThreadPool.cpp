@@ -0,0 +1,70 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+//                      ---- Construction ----
+
+sdl3::ThreadPool::ThreadPool(size_t workerCount)
+{
+    // Leave a thread for the main loop unless we were told otherwise.
+    if (workerCount == 0)
+    {
+        const size_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount                  = std::max<size_t>(1, hardwareThreads > 1 ? hardwareThreads - 1 : 1);
+    }
+
+    for (size_t i = 0; i < workerCount; i++) { m_workers.emplace_back([this]() { ThreadPool::worker_loop(); }); }
+}
+
+sdl3::ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard jobLock{m_jobMutex};
+        m_shutdown = true;
+    }
+    m_jobCondition.notify_all();
+
+    // jthreads join on their own, but the shutdown flag has to be set before that happens.
+    m_workers.clear();
+}
+
+//                      ---- Public Functions ----
+
+sdl3::ThreadPool &sdl3::ThreadPool::get_shared()
+{
+    static ThreadPool sharedPool{};
+    return sharedPool;
+}
+
+void sdl3::ThreadPool::submit(ThreadPool::Job job)
+{
+    {
+        std::lock_guard jobLock{m_jobMutex};
+        m_jobs.push(std::move(job));
+    }
+    m_jobCondition.notify_one();
+}
+
+size_t sdl3::ThreadPool::get_worker_count() const noexcept { return m_workers.size(); }
+
+//                      ---- Private Functions ----
+
+void sdl3::ThreadPool::worker_loop()
+{
+    while (true)
+    {
+        ThreadPool::Job job{};
+        {
+            std::unique_lock jobLock{m_jobMutex};
+            m_jobCondition.wait(jobLock, [this]() { return m_shutdown || !m_jobs.empty(); });
+
+            // Only exit once everything queued has been run.
+            if (m_jobs.empty()) { return; }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop();
+        }
+
+        job();
+    }
+}
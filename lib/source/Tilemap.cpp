@@ -0,0 +1,224 @@
+#include "Tilemap.hpp"
+
+#include "Renderer.hpp"
+
+#include <algorithm>
+
+//                      ---- Construction ----
+
+sdl3::Tilemap::Tilemap(sdl3::SharedTexture tileset, int tileWidth, int tileHeight, int columns, int rows)
+    : m_tileset{std::move(tileset)}
+    , m_tileWidth{tileWidth}
+    , m_tileHeight{tileHeight}
+    , m_columns{std::max(columns, 0)}
+    , m_rows{std::max(rows, 0)}
+    , m_chunkColumns{(m_columns + CHUNK_TILES - 1) / CHUNK_TILES}
+    , m_chunkRows{(m_rows + CHUNK_TILES - 1) / CHUNK_TILES}
+    , m_tiles(static_cast<size_t>(m_columns) * m_rows, EMPTY_TILE)
+    , m_chunks(static_cast<size_t>(m_chunkColumns) * m_chunkRows)
+{}
+
+sdl3::Tilemap::~Tilemap()
+{
+    for (Tilemap::Chunk &chunk : m_chunks) { Tilemap::release_chunk(chunk); }
+}
+
+//                      ---- Public Functions ----
+
+void sdl3::Tilemap::initialize(sdl3::Renderer &renderer) { sm_renderer = &renderer; }
+
+bool sdl3::Tilemap::set_tile(int column, int row, uint16_t tile)
+{
+    if (column < 0 || column >= m_columns || row < 0 || row >= m_rows) { return false; }
+
+    uint16_t &current = m_tiles[static_cast<size_t>(row) * m_columns + column];
+    if (current == tile) { return true; }
+
+    current = tile;
+    m_chunks[static_cast<size_t>(row / CHUNK_TILES) * m_chunkColumns + column / CHUNK_TILES].dirty = true;
+
+    return true;
+}
+
+uint16_t sdl3::Tilemap::get_tile(int column, int row) const noexcept
+{
+    if (column < 0 || column >= m_columns || row < 0 || row >= m_rows) { return EMPTY_TILE; }
+
+    return m_tiles[static_cast<size_t>(row) * m_columns + column];
+}
+
+void sdl3::Tilemap::fill(uint16_t tile)
+{
+    std::fill(m_tiles.begin(), m_tiles.end(), tile);
+    Tilemap::invalidate();
+}
+
+void sdl3::Tilemap::invalidate() noexcept
+{
+    for (Tilemap::Chunk &chunk : m_chunks) { chunk.dirty = true; }
+}
+
+int sdl3::Tilemap::get_columns() const noexcept { return m_columns; }
+
+int sdl3::Tilemap::get_rows() const noexcept { return m_rows; }
+
+bool sdl3::Tilemap::render(int cameraX, int cameraY)
+{
+    if (!sm_renderer || !m_tileset || m_tileWidth <= 0 || m_tileHeight <= 0) { return false; }
+
+    ++m_useClock;
+
+    // Clip the viewport to the map, then work out which chunks it touches.
+    const int left   = std::max(cameraX, 0);
+    const int top    = std::max(cameraY, 0);
+    const int right  = std::min(cameraX + sm_renderer->get_logical_width(), m_columns * m_tileWidth);
+    const int bottom = std::min(cameraY + sm_renderer->get_logical_height(), m_rows * m_tileHeight);
+    if (right <= left || bottom <= top) { return true; }
+
+    const int chunkWidth  = CHUNK_TILES * m_tileWidth;
+    const int chunkHeight = CHUNK_TILES * m_tileHeight;
+    const int firstColumn = left / chunkWidth;
+    const int lastColumn  = (right - 1) / chunkWidth;
+    const int firstRow    = top / chunkHeight;
+    const int lastRow     = (bottom - 1) / chunkHeight;
+
+    bool success = true;
+    for (int chunkRow = firstRow; chunkRow <= lastRow; chunkRow++)
+    {
+        for (int chunkColumn = firstColumn; chunkColumn <= lastColumn; chunkColumn++)
+        {
+            Tilemap::Chunk &chunk = m_chunks[static_cast<size_t>(chunkRow) * m_chunkColumns + chunkColumn];
+            chunk.lastUse         = m_useClock;
+            if (chunk.dirty && !Tilemap::bake_chunk(chunkColumn, chunkRow))
+            {
+                success = false;
+                continue;
+            }
+
+            if (chunk.empty) { continue; }
+
+            const SDL_Rect area = Tilemap::get_chunk_area(chunkColumn, chunkRow);
+            const bool rendered = chunk.target->render_part(area.x - cameraX, area.y - cameraY, 0, 0, area.w, area.h);
+            success             = rendered && success;
+        }
+    }
+
+    return success;
+}
+
+//                      ---- Private Functions ----
+
+SDL_Rect sdl3::Tilemap::get_chunk_area(int chunkColumn, int chunkRow) const noexcept
+{
+    // Chunks on the right and bottom edges can be cut short by the map.
+    const int firstColumn = chunkColumn * CHUNK_TILES;
+    const int firstRow    = chunkRow * CHUNK_TILES;
+    const int columns     = std::min(CHUNK_TILES, m_columns - firstColumn);
+    const int rows        = std::min(CHUNK_TILES, m_rows - firstRow);
+
+    return {.x = firstColumn * m_tileWidth, .y = firstRow * m_tileHeight, .w = columns * m_tileWidth, .h = rows * m_tileHeight};
+}
+
+bool sdl3::Tilemap::bake_chunk(int chunkColumn, int chunkRow)
+{
+    Tilemap::Chunk &chunk = m_chunks[static_cast<size_t>(chunkRow) * m_chunkColumns + chunkColumn];
+    chunk.dirty           = false;
+
+    // Chunks with nothing in them don't need a target at all.
+    const SDL_Rect area   = Tilemap::get_chunk_area(chunkColumn, chunkRow);
+    const int firstColumn = area.x / m_tileWidth;
+    const int firstRow    = area.y / m_tileHeight;
+    const int columns     = area.w / m_tileWidth;
+    const int rows        = area.h / m_tileHeight;
+
+    chunk.empty = true;
+    for (int row = firstRow; row < firstRow + rows && chunk.empty; row++)
+    {
+        const auto rowStart = m_tiles.begin() + (static_cast<size_t>(row) * m_columns + firstColumn);
+        chunk.empty         = std::all_of(rowStart, rowStart + columns, [](uint16_t tile) { return tile == EMPTY_TILE; });
+    }
+
+    if (chunk.empty)
+    {
+        Tilemap::release_chunk(chunk);
+        return true;
+    }
+
+    if (!chunk.target)
+    {
+        if (m_bakedCount >= MAX_BAKED_CHUNKS) { Tilemap::evict_chunk(); }
+
+        chunk.target = sm_renderer->get_target_pool().acquire(area.w, area.h);
+        if (!chunk.target)
+        {
+            chunk.dirty = true;
+            return false;
+        }
+        ++m_bakedCount;
+    }
+
+    // Render to the target and put the old one back. Tiles go through the sprite batch so the whole chunk is one draw.
+    sdl3::SharedTexture previousTarget = sm_renderer->get_render_target();
+    const bool targetSet               = sm_renderer->set_render_target(chunk.target);
+    const bool cleared                 = targetSet && sm_renderer->clear({0x00, 0x00, 0x00, 0x00});
+
+    const bool batching = sm_renderer->get_sprite_batch().is_active();
+    if (!batching) { sm_renderer->begin_batch(); }
+
+    const int tilesetColumns = std::max(m_tileset->get_width() / m_tileWidth, 1);
+    for (int row = 0; row < rows && cleared; row++)
+    {
+        for (int column = 0; column < columns; column++)
+        {
+            const uint16_t tile = m_tiles[static_cast<size_t>(firstRow + row) * m_columns + firstColumn + column];
+            if (tile == EMPTY_TILE) { continue; }
+
+            m_tileset->render_part(column * m_tileWidth,
+                                   row * m_tileHeight,
+                                   (tile % tilesetColumns) * m_tileWidth,
+                                   (tile / tilesetColumns) * m_tileHeight,
+                                   m_tileWidth,
+                                   m_tileHeight);
+        }
+    }
+
+    const bool flushed = batching || sm_renderer->end_batch();
+    sm_renderer->set_render_target(previousTarget);
+
+    // Blending onto a transparent target leaves the color multiplied by alpha already.
+    chunk.target->set_blend_mode(SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+
+    if (!cleared || !flushed) { chunk.dirty = true; }
+
+    return cleared && flushed;
+}
+
+void sdl3::Tilemap::evict_chunk()
+{
+    auto evictable    = [this](const Tilemap::Chunk &chunk) { return chunk.target && chunk.lastUse != m_useClock; };
+    auto used_earlier = [](const Tilemap::Chunk &a, const Tilemap::Chunk &b) { return a.lastUse < b.lastUse; };
+
+    // Find the oldest chunk that has a target and wasn't drawn this render.
+    Tilemap::Chunk *oldest{};
+    for (Tilemap::Chunk &chunk : m_chunks)
+    {
+        if (evictable(chunk) && (!oldest || used_earlier(chunk, *oldest))) { oldest = &chunk; }
+    }
+
+    if (oldest)
+    {
+        Tilemap::release_chunk(*oldest);
+        oldest->dirty = true;
+    }
+}
+
+void sdl3::Tilemap::release_chunk(Tilemap::Chunk &chunk)
+{
+    if (!chunk.target) { return; }
+
+    // This can happen mid render with earlier draws of the target still batched. A target the pool hands out again is
+    // flushed when it's set as the render target, and one the pool drops flushes the batch before it's destroyed.
+    if (sm_renderer) { sm_renderer->get_target_pool().release(chunk.target); }
+    chunk.target.reset();
+    --m_bakedCount;
+}
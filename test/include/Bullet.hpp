@@ -13,7 +13,7 @@ class Bullet final : public Object
         void update(Game &game, const Input &input) override;
 
         /// @brief Renders the pellet to screen.
-        void render(Game &game, sdl3::Renderer &renderer) override;
+        void render(Game &game, sdl3::DrawList &drawList) override;
 
     private:
         /// @brief Loads the sprite if it hasn't been already.
@@ -1,6 +1,8 @@
 #pragma once
 #include "Object.hpp"
 
+#include <array>
+
 class Enemy final : public Object
 {
     public:
@@ -22,7 +24,7 @@ class Enemy final : public Object
         void update(Game &game, const Input &input) override;
 
         /// @brief Enemy render routine.
-        void render(Game &game, sdl3::Renderer &renderer) override;
+        void render(Game &game, sdl3::DrawList &drawList) override;
 
     private:
         /// @brief Number of shots required to destroy the plane.
@@ -37,6 +39,9 @@ class Enemy final : public Object
         /// @brief Font used to render hit count above the enemy.
         static inline sdl3::SharedFont sm_debugFont{};
 
+        /// @brief Sprites being loaded in the background.
+        static inline std::array<sdl3::AsyncTexture, 5> sm_sprites{};
+
         /// @brief Checks for collisions with bullet instances.
         /// @param game Reference to game.
         void check_for_bullet_collisions(Game &game) noexcept;
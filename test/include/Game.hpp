@@ -20,6 +20,9 @@ class Game final
         /// @brief Returns the game objects as a span.
         std::span<const UniqueObject> get_game_objects() const noexcept;
 
+        /// @brief Returns the particle system effects spawn into.
+        sdl3::ParticleSystem &get_particles() noexcept;
+
         /// @brief Adds the passed value to the score of the player.
         /// @param addScore Score to add.
         void add_to_score(int64_t addScore) noexcept;
@@ -51,12 +54,21 @@ class Game final
         /// @brief Renderer instance.
         sdl3::Renderer m_renderer{};
 
+        /// @brief Paces frames and runs updates at a fixed rate.
+        sdl3::FramePacer m_pacer{};
+
         /// @brief Input container struct.
         Input m_input{};
 
         /// @brief Test font.
         sdl3::SharedFont m_font{};
 
+        /// @brief Draw list objects render into.
+        sdl3::DrawList m_drawList{};
+
+        /// @brief Particles for every effect. These all share ParticleA.png.
+        sdl3::ParticleSystem m_particles;
+
         /// @brief Vector of game objects.
         std::vector<std::unique_ptr<Object>> m_objects{};
 
@@ -69,7 +81,4 @@ class Game final
 
         /// @brief Purges all of the offscreen objects.
         void purge_uneeded_objects();
-
-        /// @brief Sorts the object vector by depth for rendering.
-        void sort_objects_by_depth();
 };
\ No newline at end of file
@@ -35,8 +35,8 @@ class Object
         /// @brief Virtual update.
         virtual void update(Game &game, const Input &input) {};
 
-        /// @brief Virtual render.
-        virtual void render(Game &game, sdl3::Renderer &renderer) {};
+        /// @brief Virtual render. Objects queue what they draw into the draw list instead of drawing right away.
+        virtual void render(Game &game, sdl3::DrawList &drawList) {};
 
         /// @brief Return the X coordinate.
         int get_x() const noexcept { return m_x; }
@@ -53,6 +53,15 @@ class Object
         /// @brief Return the depth.
         int get_depth() const noexcept { return m_depth; }
 
+        /// @brief Returns the draw list sort key for the object. Deeper objects are drawn first.
+        /// @param textureId Id of the texture being drawn. 0 for anything else.
+        uint64_t get_sort_key(uint32_t textureId) const noexcept
+        {
+            // Depth is flipped and biased so higher depths end up with lower keys.
+            const uint16_t depthKey = static_cast<uint16_t>(0x8000 - m_depth);
+            return sdl3::DrawList::make_key(0, depthKey, textureId, 0);
+        }
+
         /// @brief Returns the object type.
         Type get_type() const noexcept { return m_type; }
 
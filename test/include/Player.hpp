@@ -11,7 +11,7 @@ class Player final : public Object
         void update(Game &game, const Input &input) override;
 
         /// @brief Renders the player sprite to screen.
-        void render(Game &game, sdl3::Renderer &render) override;
+        void render(Game &game, sdl3::DrawList &drawList) override;
 
     private:
         /// @brief Number of ticks before the player's collision kicks in.
@@ -26,6 +26,9 @@ class Player final : public Object
         /// @brief Loads the player's texture.
         void load_player_texture();
 
+        /// @brief Spawns engine exhaust particles behind the ship.
+        void spawn_exhaust(Game &game) noexcept;
+
         /// @brief Checks for collisions.
         void check_for_collisions(Game &game) noexcept;
 };
\ No newline at end of file
@@ -12,5 +12,5 @@ class Star final : public Object
         void update(Game &game, const Input &input) override;
 
         /// @brief Renders the star.
-        void render(Game &game, sdl3::Renderer &renderer) override;
+        void render(Game &game, sdl3::DrawList &drawList) override;
 };
\ No newline at end of file
@@ -35,7 +35,8 @@ void Bullet::update(Game &game, const Input &input)
     if (m_x > LOGICAL_WIDTH) { Object::mark_for_purge(); }
 }
 
-void Bullet::render(Game &game, sdl3::Renderer &renderer) { m_sprite->render(m_x, m_y); }
+void Bullet::render(Game &game, sdl3::DrawList &drawList)
+{ drawList.add_texture(Object::get_sort_key(m_sprite->get_id()), *m_sprite, m_x, m_y); }
 
 //                      ---- Private Functions ----
 
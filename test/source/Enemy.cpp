@@ -37,8 +37,9 @@ Enemy::Enemy()
     // Grab a reference to it from the array.
     m_data = &ENEMY_TABLE[enemyIndex];
 
-    // Load the sprite.
-    m_sprite = sdl3::TextureManager::load_resource(m_data->spritePath, m_data->spritePath);
+    // Use the sprite loaded in the background if it's ready. Otherwise it has to be loaded now.
+    m_sprite = sm_sprites[enemyIndex].get();
+    if (!m_sprite) { m_sprite = sdl3::TextureManager::load_resource(m_data->spritePath, m_data->spritePath); }
 
     // Record width and height.
     m_width  = m_sprite->get_width();
@@ -75,18 +76,21 @@ void Enemy::update(Game &game, const Input &input)
     if (m_x + m_width < 0) { m_isPurgable = true; }
 }
 
-void Enemy::render(Game &game, sdl3::Renderer &renderer)
+void Enemy::render(Game &game, sdl3::DrawList &drawList)
 {
     // Color for rendering hit counts.
     static constexpr SDL_Color GREEN = {.r = 0x00, .g = 0xFF, .b = 0x00, .a = 0xFF};
 
-    // Debug stuff.
+    // Debug stuff. This has no texture id, so it's drawn before the sprite at the same depth.
     const std::string hitCount = std::format("HP: {}", m_hits);
     const size_t hitWidth      = sm_debugFont->get_text_width(hitCount);
     const int hitX             = (m_x + (m_width / 2)) - (hitWidth / 2);
-    sm_debugFont->render_text(hitX, m_y - 12, GREEN, hitCount);
+    const int hitY             = m_y - 12;
+    drawList.add_callback(Object::get_sort_key(0),
+                          [hitX, hitY, hitCount](sdl3::Renderer &renderer)
+                          { sm_debugFont->render_text(hitX, hitY, GREEN, hitCount); });
 
-    m_sprite->render(m_x, m_y);
+    drawList.add_texture(Object::get_sort_key(m_sprite->get_id()), *m_sprite, m_x, m_y);
 }
 
 //                      ---- Private Functions ----
@@ -126,4 +130,11 @@ void Enemy::initialize_static_members()
 
     if (sm_debugFont) { return; }
     sm_debugFont = sdl3::FontManager::load_resource(FONT_NAME, FONT_PATH, FONT_SIZE);
+
+    // Start loading every enemy sprite so later spawns don't have to decode them mid-frame.
+    for (size_t i = 0; i < ENEMY_COUNT; i++)
+    {
+        const std::string_view spritePath = ENEMY_TABLE[i].spritePath;
+        sm_sprites[i]                     = sdl3::TextureManager::load_resource_async(spritePath, spritePath);
+    }
 }
\ No newline at end of file
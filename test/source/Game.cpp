@@ -14,6 +14,12 @@
 namespace
 {
     constexpr std::string_view WINDOW_TITLE = "SDL3 Wrapper Test";
+
+    // Images this size or smaller are packed into texture atlas pages.
+    constexpr int SPRITE_ATLAS_THRESHOLD = 128;
+
+    // Most particles alive at once.
+    constexpr size_t PARTICLE_CAPACITY = 16384;
 }
 
 //                      ---- Construction ----
@@ -22,19 +28,35 @@ Game::Game()
     : m_sdl3{}
     , m_window{WINDOW_TITLE, WINDOW_WIDTH, WINDOW_HEIGHT}
     , m_renderer{m_window}
+    , m_particles{PARTICLE_CAPACITY}
 {
     // Path of the main font used.
     static constexpr std::string_view FONT_PATH = "./assets/MainFont.ttf";
 
+    // Path of the texture every particle uses.
+    static constexpr std::string_view PARTICLE_PATH = "./assets/ParticleA.png";
+
     // Set logical width and height.
     m_renderer.set_logical_presentation(WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2);
 
+    // Vsync paces frames if the renderer has it. Otherwise the pacer sleeps between them.
+    m_pacer.enable_vsync(m_renderer);
+
     // Init texture.
     sdl3::Texture::initialize(m_renderer);
 
+    // Every sprite in assets is tiny, so they all share atlas pages.
+    sdl3::Texture::set_atlas_threshold(SPRITE_ATLAS_THRESHOLD);
+
+    // Premultiplied sprites blend with fewer operations, which mostly helps the software renderer.
+    sdl3::Texture::set_premultiply_alpha(true);
+
     // Load the font.
     m_font = sdl3::FontManager::load_resource(FONT_PATH, FONT_PATH, 14);
 
+    // Load the particle texture.
+    m_particles.set_texture(sdl3::TextureManager::load_resource(PARTICLE_PATH, PARTICLE_PATH));
+
     // Create the player.
     m_objects.push_back(std::make_unique<Player>());
 }
@@ -45,26 +67,35 @@ int Game::run() noexcept
 {
     while (true)
     {
-        // Pump events.
-        m_sdl3.pump_events();
+        m_pacer.begin_frame();
+
+        // Input and game logic run at a fixed rate no matter how fast frames are rendered.
+        while (m_pacer.step())
+        {
+            // Pump events.
+            m_sdl3.pump_events();
+
+            // Update input.
+            m_input.keyboard.update();
+            m_input.mouse.update();
+            m_input.gamepads.update();
 
-        // Update input.
-        m_input.keyboard.update();
-        m_input.mouse.update();
-        m_input.gamepads.update();
+            // Exit on escape.
+            const bool exit = m_input.keyboard.pressed(SDL_SCANCODE_ESCAPE);
+            if (exit) { return 0; }
 
-        // Exit on escape.
-        const bool exit = m_input.keyboard.pressed(SDL_SCANCODE_ESCAPE);
-        if (exit) { return 0; }
+            Game::update();
+        }
 
-        // Game update and render.
-        Game::update();
         Game::render();
+        m_pacer.end_frame();
     }
 }
 
 std::span<const UniqueObject> Game::get_game_objects() const noexcept { return std::span<const UniqueObject>{m_objects}; }
 
+sdl3::ParticleSystem &Game::get_particles() noexcept { return m_particles; }
+
 void Game::add_to_score(int64_t addScore) noexcept { m_score += addScore; }
 
 //                      ---- Private Functions ----
@@ -82,11 +113,11 @@ void Game::update() noexcept
         m_objects.push_back(std::make_unique<Enemy>());
     }
 
-    // Re-sort the vector.
-    Game::sort_objects_by_depth();
-
     // Loop and update objects.
     for (auto &object : m_objects) { object->update(*this, m_input); }
+
+    // Particles last.
+    m_particles.update(static_cast<float>(m_pacer.get_update_delta()));
 }
 
 void Game::render() noexcept
@@ -94,20 +125,33 @@ void Game::render() noexcept
     static constexpr SDL_Color CLEAR    = {.r = 0x00, .g = 0x00, .b = 0x00, .a = 0x00};
     static constexpr SDL_Color DEB_TEXT = {.r = 0xFF, .g = 0xFF, .b = 0xFF, .a = 0xFF};
 
-    // Start the rendering process.
+    // Start the rendering process. Sprites and text are batched until the frame ends.
     m_renderer.frame_begin(CLEAR);
+    m_renderer.begin_batch();
+
+    // Particles are drawn under everything else.
+    m_particles.render();
 
-    // Loop and render objects.
-    for (auto &object : m_objects) { object->render(*this, m_renderer); }
+    // Objects queue their draws in whatever order they're stored. The draw list sorts them by depth.
+    m_drawList.clear();
+    for (auto &object : m_objects) { object->render(*this, m_drawList); }
+    m_drawList.execute(m_renderer);
 
     const sdl3::Mouse &mouse      = m_input.mouse;
-    const std::string debugString = std::format("Score: {}\nObject Count: {}\nMouse X, Y: {}, {}\nGlobal mouse X, Y: {}, {}",
-                                                m_score,
-                                                m_objects.size(),
-                                                mouse.x(),
-                                                mouse.y(),
-                                                mouse.global_x(),
-                                                mouse.global_y());
+    const sdl3::RenderCounters &counters = sdl3::RenderStats::get_frame_counters();
+    const std::string debugString =
+        std::format("Score: {}\nObject Count: {}\nMouse X, Y: {}, {}\nGlobal mouse X, Y: {}, {}\n"
+                    "Draws: {} Binds: {}\nFrame p50/p99: {:.2f}/{:.2f}ms",
+                    m_score,
+                    m_objects.size(),
+                    mouse.x(),
+                    mouse.y(),
+                    mouse.global_x(),
+                    mouse.global_y(),
+                    counters.drawCalls,
+                    counters.textureBinds,
+                    sdl3::RenderStats::get_frame_time_percentile(50.0),
+                    sdl3::RenderStats::get_frame_time_percentile(99.0));
     m_font->render_text(0, 0, DEB_TEXT, debugString);
 
     m_renderer.frame_end();
@@ -119,13 +163,4 @@ void Game::purge_uneeded_objects()
 {
     auto purge_object = [](const UniqueObject &object) { return object->is_purgable(); };
     std::erase_if(m_objects, purge_object);
-}
-
-void Game::sort_objects_by_depth()
-{
-    // Lambda for sorting.
-    auto sortLambda = [](const UniqueObject &a, const UniqueObject &b) { return a->get_depth() > b->get_depth(); };
-
-    // Sort the vector.
-    std::sort(m_objects.begin(), m_objects.end(), sortLambda);
 }
\ No newline at end of file
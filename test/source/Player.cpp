@@ -5,6 +5,7 @@
 #include "screen.hpp"
 
 #include <cmath>
+#include <cstdlib>
 #include <iostream>
 //                      ---- Construction ----
 
@@ -68,10 +69,13 @@ void Player::update(Game &game, const Input &input)
 
     if (spawnBullet) { game.create_add_object<Bullet>(m_x + BULLET_OFFSET_X, m_y + BULLET_OFFSET_Y); }
 
+    Player::spawn_exhaust(game);
+
     Player::check_for_collisions(game);
 }
 
-void Player::render(Game &game, sdl3::Renderer &renderer) { m_sprite->render(m_x, m_y); }
+void Player::render(Game &game, sdl3::DrawList &drawList)
+{ drawList.add_texture(Object::get_sort_key(m_sprite->get_id()), *m_sprite, m_x, m_y); }
 
 //                      ---- Private Functions ----
 
@@ -89,6 +93,29 @@ void Player::load_player_texture()
     m_height = m_sprite->get_height();
 }
 
+void Player::spawn_exhaust(Game &game) noexcept
+{
+    // Number of particles spawned per update.
+    static constexpr int EXHAUST_PER_UPDATE = 4;
+
+    // Exhaust starts out orange, then goes red and fades out.
+    static constexpr SDL_FColor EXHAUST_COLOR = {.r = 1.0f, .g = 0.6f, .b = 0.2f, .a = 1.0f};
+    static constexpr SDL_FColor EXHAUST_FADE  = {.r = 0.0f, .g = -1.2f, .b = -0.4f, .a = -2.0f};
+
+    sdl3::ParticleSystem &particles = game.get_particles();
+    for (int i = 0; i < EXHAUST_PER_UPDATE; i++)
+    {
+        particles.spawn({.x         = static_cast<float>(m_x),
+                         .y         = static_cast<float>(m_y + (m_height / 2)),
+                         .velocityX = -120.0f - static_cast<float>(std::rand() % 60),
+                         .velocityY = static_cast<float>((std::rand() % 41) - 20),
+                         .lifetime  = 0.5f,
+                         .size      = 6.0f,
+                         .color     = EXHAUST_COLOR,
+                         .fade      = EXHAUST_FADE});
+    }
+}
+
 void Player::check_for_collisions(Game &game) noexcept
 {
     // Point hit.
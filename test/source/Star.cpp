@@ -23,7 +23,7 @@ Star::Star()
 
 void Star::update(Game &game, const Input &input) { m_x -= m_depth; }
 
-void Star::render(Game &game, sdl3::Renderer &renderer)
+void Star::render(Game &game, sdl3::DrawList &drawList)
 {
     // This is the size to use to render.
     const float renderDimensions = 3 + m_depth;
@@ -34,6 +34,6 @@ void Star::render(Game &game, sdl3::Renderer &renderer)
                                   .w = renderDimensions,
                                   .h = renderDimensions};
 
-    SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
-    SDL_RenderFillRect(renderer, &renderRect);
+    // Stars next to each other in the list all end up in one draw.
+    drawList.add_rect(Object::get_sort_key(0), renderRect, {0xFF, 0xFF, 0xFF, 0xFF});
 }
\ No newline at end of file